@@ -288,8 +288,8 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 			pos_vtx.push_back({ -1.0f + i * stack_interval, -1.0f + j * slice_interval });
 		}
 	}
-	// generate indices
-	std::vector<GLushort> idx;
+	// generate indices, 32-bit so any number of vertices can be addressed
+	std::vector<GLuint> idx;
 	for (int row = 0; row < stacks; ++row)
 	{
 		if (row != 0)
@@ -346,9 +346,20 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 	glVertexArrayAttribFormat(vaoid, 1, 3, GL_FLOAT, GL_FALSE, 0);
 	glVertexArrayAttribBinding(vaoid, 1, 7);
 
+	// the ebo holds 16-bit indices while every vertex fits them
 	GLuint ebo_hdl;
 	glCreateBuffers(1, &ebo_hdl);
-	glNamedBufferStorage(ebo_hdl, sizeof(GLushort) * idx.size(), idx.data(), GL_DYNAMIC_STORAGE_BIT);
+	GLenum index_type = GL_UNSIGNED_INT;
+	if (pos_vtx.size() <= 65536)
+	{
+		std::vector<GLushort> idx16(idx.begin(), idx.end());
+		glNamedBufferStorage(ebo_hdl, sizeof(GLushort) * idx16.size(), idx16.data(), GL_DYNAMIC_STORAGE_BIT);
+		index_type = GL_UNSIGNED_SHORT;
+	}
+	else
+	{
+		glNamedBufferStorage(ebo_hdl, sizeof(GLuint) * idx.size(), idx.data(), GL_DYNAMIC_STORAGE_BIT);
+	}
 	glVertexArrayElementBuffer(vaoid, ebo_hdl);
 
 	glBindVertexArray(0);
@@ -358,6 +369,7 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 	mdl.primitive_type = GL_TRIANGLE_STRIP;
 	mdl.setup_shdrpgm(vtx_shdr, frg_shdr);
 	mdl.draw_cnt = idx.size(); // number of vertices
+	mdl.index_type = index_type;
 	mdl.primitive_cnt = mdl.draw_cnt / 2; // number of primitives (not used)
 	return mdl;
 }
@@ -405,10 +417,10 @@ void GLApp::GLModel::draw()
 		glLineWidth(1.f);
 		break;
 	case GL_TRIANGLE_FAN:
-		glDrawElements(primitive_type, draw_cnt, GL_UNSIGNED_SHORT, NULL);
+		glDrawElements(primitive_type, draw_cnt, index_type, NULL);
 		break;
 	case GL_TRIANGLE_STRIP:
-		glDrawElements(primitive_type, draw_cnt, GL_UNSIGNED_SHORT, NULL);
+		glDrawElements(primitive_type, draw_cnt, index_type, NULL);
 		break;
 	}
 
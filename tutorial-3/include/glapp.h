@@ -40,6 +40,7 @@ struct GLApp {
 	  GLuint		vaoid{0};			// handle to VAO
 
 	  GLuint		draw_cnt{0};		// added for tutorial 2
+	  GLenum		index_type{GL_UNSIGNED_SHORT};	// of the ebo, GL_UNSIGNED_INT for models over 65536 vertices
 
 	  //GLSLShader	shdr_pgm;		// which shader program?
 
@@ -343,8 +343,8 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 			pos_vtx.push_back({ -1.0f + i * stack_interval, -1.0f + j * slice_interval });
 		}
 	}
-	// generate indices
-	std::vector<GLushort> idx;
+	// generate indices, 32-bit so any number of vertices can be addressed
+	std::vector<GLuint> idx;
 	for (int row = 0; row < stacks; ++row)
 	{
 		if (row != 0)
@@ -401,9 +401,20 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 	glVertexArrayAttribFormat(vaoid, 1, 3, GL_FLOAT, GL_FALSE, 0);
 	glVertexArrayAttribBinding(vaoid, 1, 7);
 
+	// the ebo holds 16-bit indices while every vertex fits them
 	GLuint ebo_hdl;
 	glCreateBuffers(1, &ebo_hdl);
-	glNamedBufferStorage(ebo_hdl, sizeof(GLushort) * idx.size(), idx.data(), GL_DYNAMIC_STORAGE_BIT);
+	GLenum index_type = GL_UNSIGNED_INT;
+	if (pos_vtx.size() <= 65536)
+	{
+		std::vector<GLushort> idx16(idx.begin(), idx.end());
+		glNamedBufferStorage(ebo_hdl, sizeof(GLushort) * idx16.size(), idx16.data(), GL_DYNAMIC_STORAGE_BIT);
+		index_type = GL_UNSIGNED_SHORT;
+	}
+	else
+	{
+		glNamedBufferStorage(ebo_hdl, sizeof(GLuint) * idx.size(), idx.data(), GL_DYNAMIC_STORAGE_BIT);
+	}
 	glVertexArrayElementBuffer(vaoid, ebo_hdl);
 
 	glBindVertexArray(0);
@@ -413,6 +424,7 @@ GLApp::GLModel GLApp::tristrip_model(int slices, int stacks, std::string vtx_shd
 	mdl.primitive_type = GL_TRIANGLE_STRIP;
 	//mdl.setup_shdrpgm(vtx_shdr, frg_shdr);
 	mdl.draw_cnt = idx.size(); // number of vertices
+	mdl.index_type = index_type;
 	mdl.primitive_cnt = mdl.draw_cnt / 2; // number of primitives (not used)
 	return mdl;
 }
@@ -619,7 +631,7 @@ void GLApp::GLObject::draw() const
 	shdrpgms[shd_ref].SetUniform("uModel_to_NDC", mdl_to_ndc_xform);
 
 	// part 4: render using glDrawElements or glDrawArrays
-	glDrawElements(models[mdl_ref].primitive_type, models[mdl_ref].draw_cnt, GL_UNSIGNED_SHORT, nullptr);
+	glDrawElements(models[mdl_ref].primitive_type, models[mdl_ref].draw_cnt, models[mdl_ref].index_type, nullptr);
 }
 
 void GLApp::GLObject::update(GLdouble delta_time)
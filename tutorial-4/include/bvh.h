@@ -0,0 +1,109 @@
+/* !
+@file    bvh.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of class BVH, a bounding volume
+hierarchy of 2D axis-aligned boxes that GLApp uses to find the objects
+overlapping the camera window without testing every object in the scene.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef BVH_H
+#define BVH_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+class BVH
+/*! BVH class.
+A binary tree over items numbered from 0, each with a box. Leaves hold up
+to leaf_size items, split at the median of the longest axis of their
+centers, so the tree is balanced whatever the layout of the items. A box
+that changes is refit in place, which only walks up from its leaf; the
+tree is not rebalanced, so it is worth building again once many items have
+moved far from where they were.
+*/
+{
+public:
+	static constexpr uint32_t	leaf_size = 4;	/*!< most items per leaf */
+
+	struct AABB
+	{
+		glm::vec2	min{}, max{};
+	};
+
+	// true if two boxes share at least one point
+	static bool Overlap(AABB const& a, AABB const& b)
+	{
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+
+	/*!
+	 * @brief ___BVH::Build___
+	 * ****************************************************************************************************
+	 * Builds the tree over items 0 to bounds.size() - 1, replacing
+	 * whatever was built before.
+	 * ****************************************************************************************************
+	 * @param bounds
+	 * : Box of every item.
+	 * ****************************************************************************************************
+	*/
+	void Build(std::vector<AABB> const& bounds);
+
+	/*!
+	 * @brief ___BVH::Refit___
+	 * ****************************************************************************************************
+	 * Sets the box of an item and refits the nodes above it, up to the
+	 * first one whose box does not change.
+	 * ****************************************************************************************************
+	 * @param item
+	 * : Item to move, less than GetSize().
+	 * @param bounds
+	 * : Its new box.
+	 * ****************************************************************************************************
+	*/
+	void Refit(uint32_t item, AABB const& bounds);
+
+	/*!
+	 * @brief ___BVH::Query___
+	 * ****************************************************************************************************
+	 * Finds the items whose box overlaps a box, in no particular order.
+	 * ****************************************************************************************************
+	 * @param box
+	 * : Box to test against.
+	 * @param found
+	 * : The items found are appended.
+	 * ****************************************************************************************************
+	*/
+	void Query(AABB const& box, std::vector<uint32_t>& found) const;
+
+	size_t GetSize() const { return boxes.size(); }
+	AABB const& GetBounds(uint32_t item) const { return boxes[item]; }
+
+private:
+	struct Node
+	{
+		AABB		box;
+		uint32_t	first{ 0 };		/*!< of a leaf, its first entry of items, else its left child, the right one follows */
+		uint32_t	count{ 0 };		/*!< items of a leaf, 0 for an inner node */
+		uint32_t	parent{ 0 };	/*!< the root is its own parent */
+	};
+
+	// box around the items of a leaf or the children of an inner node
+	AABB Fit(Node const& node) const;
+
+	std::vector<Node>		nodes;	/*!< root first */
+	std::vector<uint32_t>	items;	/*!< grouped by leaf */
+	std::vector<uint32_t>	leaf;	/*!< leaf node of every item */
+	std::vector<AABB>		boxes;	/*!< box of every item */
+};
+
+#endif /* BVH_H */
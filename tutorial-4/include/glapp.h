@@ -23,11 +23,14 @@ and transformations (in later labs).
 ----------------------------------------------------------------------------- */
 #include <GL/glew.h> // for access to OpenGL API declarations 
 #include <GLFW/glfw3.h>
+#include <bvh.h>
 #include <glhelper.h>
 #include <glslshader.h>
 #include <list>
 #include <random>
 #include <map>
+#include <string>
+#include <vector>
 
 struct GLApp {
   static void init();
@@ -40,6 +43,8 @@ struct GLApp {
 	  GLuint		primitive_cnt{0};	// added for tutorial 2
 	  GLuint		vaoid{0};			// handle to VAO
 	  GLuint		draw_cnt{0};		// added for tutorial 2
+	  GLenum		index_type{GL_UNSIGNED_SHORT};	// of the ebo, GL_UNSIGNED_INT for models over 65536 vertices
+	  glm::vec2		extent{};			// largest |x| and |y| of the model's vertices
   };
 
   // ___________________________________________________________________________________
@@ -62,11 +67,13 @@ struct GLApp {
   static void insert_shdrpgm(std::string shdr_pgm_name, std::string vtx_shdr, std::string frg_shdr);
   /*!
    * @brief init_scene
-   *	Initializes scene from a .scn file.
+   *	Initializes scene from a .scn file, or from a scene compiled from one
+   *	by SceneFile::Compile(), which is used straight from its mapping.
    * @param scene_filename
    *	Filename of the scene.
   */
   static void init_scene(std::string scene_filename);
+  static std::string scene_filename;	/*!< scene GLApp::init() loads */
 
   struct GLObject
   {
@@ -103,10 +110,18 @@ struct GLApp {
 	  
 	  // function to update the object's model transformation matrix
 	  void update(GLdouble delta_time);
+
+	  // world-space box around the object at any orientation, so spinning
+	  // objects keep the same box and only moving or scaling changes it
+	  BVH::AABB world_bounds() const;
   };
   // removed in tutorial 3
   //static std::list<GLApp::GLObject> objects;	// singleton
-  static std::map<std::string, GLObject>	objects;	// singleton
+  // removed to load scenes without an allocation per object
+  //static std::map<std::string, GLObject>	objects;	// singleton
+  static std::vector<GLObject>				objects;	/*!< singleton, sorted by name */
+  static size_t								camera_obj;	/*!< index of the object named Camera */
+  static BVH								bvh;		/*!< over the world_bounds() of objects, refit in update() */
   static std::map<std::string, GLSLShader>	shdrpgms;	// singleton
   static std::map<std::string, GLModel>		models;	// singleton
 
@@ -0,0 +1,245 @@
+/* !
+@file    scenefile.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace SceneFile, which reads the
+scenes GLApp::init_scene() builds, either from a text .scn file and the
+.msh files of its models, or from a compiled scene: a single binary file
+holding everything the text files say, laid out so it can be used straight
+from a mapping of the file.
+
+A compiled scene, little-endian, is a SceneFile::Header followed by the
+arrays of SceneFile::Array, each starting on a SceneFile::alignment byte
+boundary:
+- the objects in structure of arrays form, sorted by name, their models
+  and shader programs as indices into the model and program arrays,
+- one SceneFile::Model per model, a range of the shared vertex and index
+  arrays,
+- one SceneFile::Program per shader program,
+- the vertices, 2 floats each, and the indices of all models: GLushort
+  for models of up to 65536 vertices, GLuint for larger ones,
+- the names and shader paths, NUL-terminated, referred to by their offset.
+
+A compiled scene is made with
+  tutorial-4 -compile <scene.scn> <scene.scb>
+and is loaded wherever a .scn file is, the two are told apart by their
+first bytes.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <mappedfile.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * @brief ___SceneFile___
+ * *********************
+ * Namespace that parses, compiles and maps scenes.
+*/
+namespace SceneFile
+{
+	// bump whenever the layout changes, older compiled scenes are then refused
+	constexpr uint32_t	version = 2;
+	constexpr size_t	alignment = 64;		/*!< of every array, one cache line */
+
+	// arrays of a compiled scene, in file order
+	enum Array : uint32_t
+	{
+		ObjectColor,		/*!< 3 floats per object, r g b */
+		ObjectScaling,		/*!< 2 floats per object */
+		ObjectOrientation,	/*!< 2 floats per object, angle and angular speed in radians */
+		ObjectPosition,		/*!< 2 floats per object */
+		ObjectModel,		/*!< uint32_t per object, index of its model */
+		ObjectProgram,		/*!< uint32_t per object, index of its shader program */
+		ObjectName,			/*!< uint32_t per object, offset of its name in Strings */
+		Models,				/*!< SceneFile::Model per model */
+		Programs,			/*!< SceneFile::Program per shader program */
+		Vertices,			/*!< 2 floats per vertex */
+		Indices16,			/*!< GLushort per index of models with GL_UNSIGNED_SHORT indices */
+		Indices32,			/*!< GLuint per index of models with GL_UNSIGNED_INT indices */
+		Strings,			/*!< NUL-terminated strings */
+		ArrayCount
+	};
+
+	/*!
+	 * @brief ___SceneFile::Header___
+	 * *******************************
+	 * First bytes of a compiled scene.
+	*/
+	struct Header
+	{
+		char		magic[8];				/*!< "GLSCENE1" */
+		uint32_t	version;				/*!< SceneFile::version of the writer */
+		uint32_t	header_size;			/*!< sizeof(Header) */
+		uint32_t	object_cnt;
+		uint32_t	model_cnt;
+		uint32_t	program_cnt;
+		uint32_t	vertex_cnt;
+		uint32_t	index16_cnt;
+		uint32_t	index32_cnt;
+		uint32_t	string_size;			/*!< bytes of Strings */
+		uint64_t	offset[ArrayCount];		/*!< of every array from the start of the file */
+	};
+
+	/*!
+	 * @brief ___SceneFile::Model___
+	 * *******************************
+	 * A model, read from ../meshes/<name>.msh.
+	*/
+	struct Model
+	{
+		uint32_t	name;					/*!< offset in Strings */
+		uint32_t	primitive_type;			/*!< GL_TRIANGLES or GL_TRIANGLE_FAN */
+		uint32_t	index_type;				/*!< GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, which index array */
+		uint32_t	first_vertex, vertex_cnt;
+		uint32_t	first_index, index_cnt;	/*!< indices count from the model's first vertex */
+	};
+
+	/*!
+	 * @brief ___SceneFile::Program___
+	 * *******************************
+	 * A shader program, as the first object that uses it names it.
+	*/
+	struct Program
+	{
+		uint32_t	name, vertex_shader, fragment_shader;	/*!< offsets in Strings */
+	};
+
+	/*!
+	 * @brief ___SceneFile::View___
+	 * *******************************
+	 * The arrays of a scene, wherever they are, in a compiled scene's
+	 * layout. The arrays of a View from Map() live in the mapping, those of
+	 * a View from Scene::GetView() in the Scene.
+	*/
+	struct View
+	{
+		uint32_t		object_cnt{ 0 }, model_cnt{ 0 }, program_cnt{ 0 };
+		uint32_t		vertex_cnt{ 0 }, index16_cnt{ 0 }, index32_cnt{ 0 }, string_size{ 0 };
+		float const*	color{ nullptr };
+		float const*	scaling{ nullptr };
+		float const*	orientation{ nullptr };
+		float const*	position{ nullptr };
+		uint32_t const*	model{ nullptr };
+		uint32_t const*	program{ nullptr };
+		uint32_t const*	name{ nullptr };
+		Model const*	models{ nullptr };
+		Program const*	programs{ nullptr };
+		float const*	vertices{ nullptr };
+		GLushort const*	indices16{ nullptr };
+		GLuint const*	indices32{ nullptr };
+		char const*		strings{ nullptr };
+
+		char const* String(uint32_t offset) const { return strings + offset; }
+
+		// indices of a model, in the array its index_type names
+		void const* Indices(Model const& m) const
+		{
+			return m.index_type == GL_UNSIGNED_INT ?
+				static_cast<void const*>(indices32 + m.first_index) : indices16 + m.first_index;
+		}
+	};
+
+	/*!
+	 * @brief ___SceneFile::Scene___
+	 * *******************************
+	 * A scene parsed from text, its arrays as in a compiled scene.
+	*/
+	struct Scene
+	{
+		std::vector<float>		color, scaling, orientation, position;
+		std::vector<uint32_t>	model, program, name;
+		std::vector<Model>		models;
+		std::vector<Program>	programs;
+		std::vector<float>		vertices;
+		std::vector<GLushort>	indices16;
+		std::vector<GLuint>		indices32;
+		std::string				strings;
+
+		View GetView() const;
+	};
+
+	// true if bytes start like a compiled scene, which may still be invalid
+	bool IsCompiled(unsigned char const* bytes, size_t size);
+
+	/*!
+	 * @brief ___SceneFile::Parse___
+	 * ****************************************************************************************************
+	 * Parses a text scene and reads the .msh file of each of its models.
+	 * Objects sharing a name are one object, the last one.
+	 * ****************************************************************************************************
+	 * @param text
+	 * : Contents of the .scn file.
+	 * @param scene
+	 * : Empty scene to parse into.
+	 * @return bool
+	 * : False, after printing why, if the text is cut short or a mesh could
+	 * not be read.
+	 * ****************************************************************************************************
+	*/
+	bool Parse(std::string const& text, Scene& scene);
+
+	/*!
+	 * @brief ___SceneFile::Map___
+	 * ****************************************************************************************************
+	 * Points a view at the arrays of a compiled scene, nothing is copied.
+	 * ****************************************************************************************************
+	 * @param file
+	 * : Mapping of the compiled scene, which must stay open while the view
+	 * is used.
+	 * @param view
+	 * : Set to the scene's arrays.
+	 * @return bool
+	 * : False, after printing why, if the file is not a compiled scene this
+	 * build can read, or refers to anything outside its arrays.
+	 * ****************************************************************************************************
+	*/
+	bool Map(MappedFile const& file, View& view);
+
+	/*!
+	 * @brief ___SceneFile::Load___
+	 * ****************************************************************************************************
+	 * Views a scene file of either kind: a compiled scene is mapped, a text
+	 * scene is parsed into scene.
+	 * ****************************************************************************************************
+	 * @param file
+	 * : Mapping of the scene file, which must stay open while the view is
+	 * used.
+	 * @param scene
+	 * : Empty scene to parse a text scene into, which must outlive the view.
+	 * @param view
+	 * : Set to the scene's arrays.
+	 * @return bool
+	 * : False, after printing why, if Parse() or Map() failed.
+	 * ****************************************************************************************************
+	*/
+	bool Load(MappedFile const& file, Scene& scene, View& view);
+
+	/*!
+	 * @brief ___SceneFile::Compile___
+	 * ****************************************************************************************************
+	 * Compiles a text scene and its meshes into a single binary file.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the .scn file, or of a compiled scene to rewrite.
+	 * @param destination
+	 * : Path of the compiled scene to write.
+	 * @return bool
+	 * : False, after printing why, if the scene could not be read or the
+	 * compiled scene could not be written.
+	 * ****************************************************************************************************
+	*/
+	bool Compile(std::string const& source, std::string const& destination);
+}
+
+#endif /* SCENEFILE_H */
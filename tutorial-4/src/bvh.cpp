@@ -0,0 +1,213 @@
+/* !
+@file    bvh.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of member functions of class BVH
+declared in bvh.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <bvh.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+/*                                                   objects with file scope
+----------------------------------------------------------------------------- */
+namespace
+{
+	bool Same(BVH::AABB const& a, BVH::AABB const& b)
+	{
+		return a.min == b.min && a.max == b.max;
+	}
+
+	// no node is deeper than this below the root of a median split tree
+	// of up to 2^32 items
+	constexpr size_t max_depth = 64;
+}
+
+/*!
+ * @brief ___BVH::Build___
+ * ****************************************************************************************************
+ * Builds the tree over items 0 to bounds.size() - 1, replacing
+ * whatever was built before.
+ * ****************************************************************************************************
+ * @param bounds
+ * : Box of every item.
+ * ****************************************************************************************************
+*/
+void BVH::Build(std::vector<AABB> const& bounds)
+{
+	boxes = bounds;
+	items.resize(boxes.size());
+	std::iota(items.begin(), items.end(), 0u);
+	leaf.assign(boxes.size(), 0);
+	nodes.clear();
+	if (boxes.empty())
+	{
+		return;
+	}
+
+	// ranges of items still to be split, with the node each becomes
+	struct Range
+	{
+		uint32_t	node, first, count;
+	};
+	std::vector<Range> ranges{ { 0, 0, static_cast<uint32_t>(boxes.size()) } };
+	nodes.reserve(boxes.size() * 2);
+	nodes.push_back(Node{});
+	while (!ranges.empty())
+	{
+		Range range = ranges.back();
+		ranges.pop_back();
+		auto begin = items.begin() + range.first;
+		if (range.count <= leaf_size)
+		{
+			nodes[range.node].first = range.first;
+			nodes[range.node].count = range.count;
+			for (auto i = begin; i != begin + range.count; ++i)
+			{
+				leaf[*i] = range.node;
+			}
+			continue;
+		}
+
+		// centers are kept doubled, min + max, it is only their order that counts
+		float const big = std::numeric_limits<float>::max();
+		glm::vec2 lo(big), hi(-big);
+		for (auto i = begin; i != begin + range.count; ++i)
+		{
+			glm::vec2 center = boxes[*i].min + boxes[*i].max;
+			lo = glm::min(lo, center);
+			hi = glm::max(hi, center);
+		}
+		int axis = hi.x - lo.x >= hi.y - lo.y ? 0 : 1;
+		uint32_t half = range.count / 2;
+		std::nth_element(begin, begin + half, begin + range.count, [&](uint32_t a, uint32_t b)
+		{
+			return boxes[a].min[axis] + boxes[a].max[axis] < boxes[b].min[axis] + boxes[b].max[axis];
+		});
+
+		uint32_t left = static_cast<uint32_t>(nodes.size());
+		nodes.resize(nodes.size() + 2);
+		nodes[left].parent = nodes[left + 1].parent = range.node;
+		nodes[range.node].first = left;
+		nodes[range.node].count = 0;
+		ranges.push_back({ left, range.first, half });
+		ranges.push_back({ left + 1, range.first + half, range.count - half });
+	}
+
+	// children always come after their parent
+	for (size_t n = nodes.size(); n-- > 0; )
+	{
+		nodes[n].box = Fit(nodes[n]);
+	}
+}
+
+/*!
+ * @brief ___BVH::Refit___
+ * ****************************************************************************************************
+ * Sets the box of an item and refits the nodes above it, up to the
+ * first one whose box does not change.
+ * ****************************************************************************************************
+ * @param item
+ * : Item to move, less than GetSize().
+ * @param bounds
+ * : Its new box.
+ * ****************************************************************************************************
+*/
+void BVH::Refit(uint32_t item, AABB const& bounds)
+{
+	if (Same(boxes[item], bounds))
+	{
+		return;
+	}
+	boxes[item] = bounds;
+	for (uint32_t n = leaf[item]; ; n = nodes[n].parent)
+	{
+		AABB box = Fit(nodes[n]);
+		if (Same(box, nodes[n].box))
+		{
+			return;
+		}
+		nodes[n].box = box;
+		if (n == 0)
+		{
+			return;
+		}
+	}
+}
+
+/*!
+ * @brief ___BVH::Query___
+ * ****************************************************************************************************
+ * Finds the items whose box overlaps a box, in no particular order.
+ * ****************************************************************************************************
+ * @param box
+ * : Box to test against.
+ * @param found
+ * : The items found are appended.
+ * ****************************************************************************************************
+*/
+void BVH::Query(AABB const& box, std::vector<uint32_t>& found) const
+{
+	if (nodes.empty())
+	{
+		return;
+	}
+	uint32_t stack[max_depth + 1];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		Node const& node = nodes[stack[--top]];
+		if (!Overlap(node.box, box))
+		{
+			continue;
+		}
+		if (node.count == 0)
+		{
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; ++i)
+		{
+			if (Overlap(boxes[items[i]], box))
+			{
+				found.push_back(items[i]);
+			}
+		}
+	}
+}
+
+/*!
+ * @brief ___BVH::Fit___
+ * ****************************************************************************************************
+ * Box around the items of a leaf or the children of an inner node.
+ * ****************************************************************************************************
+ * @param node
+ * : Node to fit, the boxes of its children must be up to date.
+ * @return AABB
+ * : The box.
+ * ****************************************************************************************************
+*/
+BVH::AABB BVH::Fit(Node const& node) const
+{
+	if (node.count == 0)
+	{
+		AABB const& a = nodes[node.first].box;
+		AABB const& b = nodes[node.first + 1].box;
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+	AABB box = boxes[items[node.first]];
+	for (uint32_t i = node.first + 1; i < node.first + node.count; ++i)
+	{
+		box.min = glm::min(box.min, boxes[items[i]].min);
+		box.max = glm::max(box.max, boxes[items[i]].max);
+	}
+	return box;
+}
@@ -14,12 +14,15 @@ to OpenGL implementations.
 ----------------------------------------------------------------------------- */
 #include <glapp.h>
 #include <glhelper.h>
+#include <scenefile.h>
 
 #include <iostream>
+#include <algorithm>
 #include <array>
 
 #include <glm/gtc/type_ptr.hpp>
 #include <chrono>
+#include <cstring>
 #include <sstream>
 
 /*                                                   objects with file scope
@@ -30,7 +33,10 @@ std::vector<GLApp::GLViewport> GLApp::vps;
 // added in tutorial 4 define singleton containers
 std::map<std::string, GLSLShader>		GLApp::shdrpgms;
 std::map<std::string, GLApp::GLModel>	GLApp::models;
-std::map<std::string, GLApp::GLObject>	GLApp::objects;
+std::vector<GLApp::GLObject>			GLApp::objects;
+size_t									GLApp::camera_obj = 0;
+BVH										GLApp::bvh;
+std::string								GLApp::scene_filename = "../scenes/tutorial-4.scn";
 
 GLApp::Camera2D GLApp::camera2d;
 
@@ -42,6 +48,7 @@ bool		create_objects		= true;		/*!< flag to create/kill objects */
 int			polymode			= 0;		/*!< polygon render mode */
 int			box_count			= 0;		/*!< number of boxes */
 int			mystery_count		= 0;		/*!< number of mystery shapes */
+std::vector<uint32_t>	visible;					/*!< objects overlapping the camera window, kept so draw() does not allocate */
 
 void GLApp::init() {
   // empty for now
@@ -52,10 +59,10 @@ void GLApp::init() {
 	glViewport(0, 0, GLHelper::width, GLHelper::height);
 
 	// part 3 - init_scene()
-	GLApp::init_scene("../scenes/tutorial-4.scn");
+	GLApp::init_scene(GLApp::scene_filename);
 
 	// part 4 - initialize camera
-	GLApp::camera2d.init(GLHelper::ptr_window, &GLApp::objects.at("Camera"));
+	GLApp::camera2d.init(GLHelper::ptr_window, &GLApp::objects[GLApp::camera_obj]);
 	
 	// part 5: print GPU specs ...
 	GLHelper::print_specs();
@@ -69,10 +76,15 @@ void GLApp::update(double delta_time) {
 	// first, update camera
 	GLApp::camera2d.update(GLHelper::ptr_window, delta_time);
 
-	// for each objects, update orientation
-	for (auto& o : GLApp::objects)
+	// for each objects, update orientation, and refit the boxes of those
+	// that moved; the camera is drawn whatever its box, so it is not refit
+	for (size_t i = 0; i < GLApp::objects.size(); ++i)
 	{
-		o.second.update(delta_time);
+		GLApp::objects[i].update(delta_time);
+		if (i != camera_obj)
+		{
+			bvh.Refit(static_cast<uint32_t>(i), GLApp::objects[i].world_bounds());
+		}
 	}
 
 	keyPlast = GLHelper::keystateP;
@@ -81,6 +93,18 @@ void GLApp::update(double delta_time) {
 }
 
 void GLApp::draw() {
+	// world-space box around the camera window, which turns with the
+	// camera when it takes the camera object's orientation
+	glm::vec2 half{ camera2d.ar * camera2d.height * 0.5f, camera2d.height * 0.5f };
+	glm::vec2 reach = glm::abs(camera2d.right) * half.x + glm::abs(camera2d.up) * half.y;
+	BVH::AABB view{ camera2d.pgo->position - reach, camera2d.pgo->position + reach };
+
+	// the objects overlapping it, in the same order as all of them
+	visible.clear();
+	bvh.Query(view, visible);
+	std::sort(visible.begin(), visible.end());
+	visible.erase(std::remove(visible.begin(), visible.end(), static_cast<uint32_t>(camera_obj)), visible.end());
+
 	// title bar
 	std::stringstream ss;
 	ss << std::fixed;
@@ -89,21 +113,19 @@ void GLApp::draw() {
 		<< "FPS: " << GLHelper::fps << " | "
 		<< "Camera position: (" << camera2d.pgo->position.x << "," << camera2d.pgo->position.y << ") | "
 		<< "Camera orientation: " << (int)(camera2d.pgo->orientation.x * (180.0f / 3.14f)) << " degrees | "
-		<< "Window height: " << camera2d.height;
+		<< "Window height: " << camera2d.height << " | "
+		<< "Objects drawn: " << visible.size() + 1 << "/" << objects.size();
 	glfwSetWindowTitle(GLHelper::ptr_window, ss.str().c_str());
 
 	// clear back buffer as before
 	glClear(GL_COLOR_BUFFER_BIT);
 
-	// render all objects
-	for (auto& o : GLApp::objects)
+	// render the visible objects, the camera last
+	for (uint32_t i : visible)
 	{
-		if (o.first != "Camera")
-		{
-			o.second.draw();
-		}
+		GLApp::objects[i].draw();
 	}
-	objects["Camera"].draw();
+	objects[camera_obj].draw();
 }
 
 void GLApp::cleanup() {
@@ -149,117 +171,68 @@ void GLApp::init_scene(std::string scene_filename)
 	/*
 		Step 1:
 		==========
-		Open the scene file and check if successful.
+		Map the scene file and view its arrays. A compiled scene is used
+		where it lies in the mapping, a text scene is parsed along with the
+		.msh files of its models. Either way the objects come sorted by name.
 	*/
-	std::ifstream ifs{ scene_filename, std::ios::in };
-	if (!ifs)
+	MappedFile file;
+	if (!file.Open(scene_filename))
 	{
 		std::cout << "ERROR: Unable to open scene file: "
 			<< scene_filename << "\n";
 		exit(EXIT_FAILURE);
 	}
-	/*	Puts file cursor to the start of the file. */
-	ifs.seekg(0, std::ios::beg);
+	SceneFile::Scene parsed;
+	SceneFile::View scene;
+	if (!SceneFile::Load(file, parsed, scene))
+	{
+		std::cout << "ERROR: Unable to load scene file: "
+			<< scene_filename << "\n";
+		exit(EXIT_FAILURE);
+	}
 
 	/*
 		Step 2:
 		==========
-		Read the object count, i.e. number of objects to create in the scene.
+		Create each shader program that is not in shdrpgms yet, and
+		remember where each one is so objects can refer to it by index.
 	*/
-	std::string line;
-	getline(ifs, line);
-	std::istringstream line_sstm{ line };
-	int obj_cnt;
-	line_sstm >> obj_cnt;	// read count of objects in scene
+	std::vector<std::map<std::string, GLSLShader>::iterator> shd_refs(scene.program_cnt);
+	for (uint32_t p = 0; p < scene.program_cnt; ++p)
+	{
+		SceneFile::Program const& program = scene.programs[p];
+		std::string shdrname = scene.String(program.name);
+		if (shdrpgms.find(shdrname) == shdrpgms.end())
+		{
+			// shader not found - create shader
+			GLApp::VPSS shdr_file_names{
+				std::make_pair<std::string, std::string>
+					(scene.String(program.vertex_shader), scene.String(program.fragment_shader))
+			};
+			GLApp::init_shdrpgms_cont(shdrname, shdr_file_names);
+		}
+		shd_refs[p] = shdrpgms.find(shdrname);
+	}
+
 	/*
 		Step 3:
 		==========
-		For each object count:
-		1. Create a new GLObject 
-		2. Read the model name and check if model already exist in models container
-			if not, load the model from the ../meshes/*.msh file.
-		3. 
+		Create a vbo, vao, and ebo for each model that is not in models yet,
+		straight from the scene's vertex and index arrays.
 	*/
-	while (obj_cnt--)
+	std::vector<std::map<std::string, GLModel>::iterator> mdl_refs(scene.model_cnt);
+	for (uint32_t m = 0; m < scene.model_cnt; ++m)
 	{
-		/* 1. Create a new GLObject */
-		GLObject new_object;
-
-		/* 2. Read the model name */
-		getline(ifs, line);	// 1st parameter: model's name
-		std::istringstream line_modelname{ line };
-		std::string model_name;
-		line_modelname >> model_name;
-
-		/* Check if model already exist in models container */
+		SceneFile::Model const& model = scene.models[m];
+		std::string model_name = scene.String(model.name);
 		if (models.find(model_name) == models.end())
 		{
-			// Not exist - read model from file and create new vao
-			/* Create new GLModel object to store the new model to be read from file */
 			GLModel new_model;
-
-			/* Open model file */
-			std::ifstream ifs{ "../meshes/"+model_name+".msh" , std::ios::in };
-			if (!ifs)
-			{
-				std::cout << "ERROR: Unable to open mesh file: "
-					<< model_name << "\n";
-				exit(EXIT_FAILURE);
-			}
-			ifs.seekg(0, std::ios::beg);
-			
-			/* Create 2 containers, one for vertices and one for indices */
-			std::vector<float> vertices;
-			std::vector<GLushort> indices;
-			std::string line;
-
-			/* Read each line in the models file */
-			while (std::getline(ifs, line))
-			{
-				/* Read the first character of the line */
-				std::istringstream iss (line);
-				char c; double vertex; int index;
-				iss >> c;
-				
-				/*	if n: do nothing, it is the model name 
-					if v: they are vertices, push the remaining line into the vertices container
-					if t: they are indices of GL_TRIANGLES, push the remaining line into the indices container
-					if f: they are indices of GL_TRIANGLE_FAN, push the remaining line into the indices container */
-				switch (c)
-				{
-				case 'n':
-					break;
-				case 'v':
-					while (iss >> vertex)
-					{
-						vertices.push_back((float)vertex);
-					}
-					break;
-				case 't':
-					// reading indices
-					while (iss >> index)
-					{
-						indices.push_back(index);
-					}
-					new_model.primitive_type = GL_TRIANGLES;
-					break;
-				case 'f':
-					// reading indices
-					while (iss >> index)
-					{
-						indices.push_back(index);
-					}
-					new_model.primitive_type = GL_TRIANGLE_FAN;
-					break;
-				}
-			}
-
-			/* Create a new vbo, vao, and ebo from the vertices and indices containers read above */
-			// create new mdl_ref
 			GLuint vbo, vao, ebo;
 			// vbo
 			glCreateBuffers(1, &vbo);
-			glNamedBufferStorage(vbo, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_STORAGE_BIT);
+			glNamedBufferStorage(vbo, model.vertex_cnt * 2 * sizeof(float),
+				scene.vertices + 2 * static_cast<size_t>(model.first_vertex), GL_DYNAMIC_STORAGE_BIT);
 			// vao
 			glCreateVertexArrays(1, &vao);
 			glEnableVertexArrayAttrib(vao, 0);
@@ -268,97 +241,63 @@ void GLApp::init_scene(std::string scene_filename)
 			glVertexArrayAttribBinding(vao, 0, 5);
 			// ebo
 			glCreateBuffers(1, &ebo);
-			glNamedBufferStorage(ebo, indices.size() * sizeof(GLushort), indices.data(), GL_DYNAMIC_STORAGE_BIT);
+			GLsizeiptr index_size = model.index_type == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+			glNamedBufferStorage(ebo, model.index_cnt * index_size,
+				scene.Indices(model), GL_DYNAMIC_STORAGE_BIT);
 			glVertexArrayElementBuffer(vao, ebo);
 			// unbind vao
 			glBindVertexArray(0);
-			
-			/* Give the new GLModel created above all the details of the loaded model from file */
+
+			new_model.primitive_type = model.primitive_type;
 			new_model.vaoid = vao;
-			new_model.draw_cnt = indices.size();
+			new_model.draw_cnt = model.index_cnt;
+			new_model.index_type = model.index_type;
 			new_model.primitive_cnt = 0;	// not used
-			/* Push the new GLModel back into the models container */
+			float const* vertex = scene.vertices + 2 * static_cast<size_t>(model.first_vertex);
+			for (uint32_t v = 0; v < model.vertex_cnt; ++v, vertex += 2)
+			{
+				new_model.extent = glm::max(new_model.extent, glm::abs(glm::make_vec2(vertex)));
+			}
 			models[model_name] = new_model;
-			// give new_object model ref
-			/* Give the new GLObject created above the model reference that is now in the models container */
-			new_object.mdl_ref = models.find(model_name);
-		}
-		else
-		{
-			// exist - use existing mdl_ref
-			/* Give the new GLObject created above the model reference that already exists in the models container */
-			new_object.mdl_ref = models.find(model_name);
 		}
+		mdl_refs[m] = models.find(model_name);
+	}
 
-		// get name of object
-		std::getline(ifs, line);
-		std::istringstream line_objectname{ line };
-		std::string object_name;
-		line_objectname >> object_name;
-
-		/* TODO: if shader program listed in the scene file is not present in
-		std::map container called shdrpgms, then add this shader to the container */
-		std::getline(ifs, line);
-		std::istringstream line_shdrname{ line };
-		std::string shdrname, vertfile, fragfile;
-		line_shdrname >> shdrname >> vertfile >> fragfile;
-		if (shdrpgms.find(shdrname) == shdrpgms.end())
-		{
-			// shader not found - create shader
-			GLApp::VPSS shdr_file_names{
-			std::make_pair<std::string, std::string>
-				(vertfile.c_str(), fragfile.c_str())
-			};
-			GLApp::init_shdrpgms_cont(shdrname, shdr_file_names);
-			// reference shader
-			new_object.shd_ref = shdrpgms.find(shdrname);
-		}
-		else
+	/*
+		Step 4:
+		==========
+		Fill the objects container in one allocation from the object
+		arrays, find the camera, and build the hierarchy draw() finds the
+		objects in the camera window with.
+	*/
+	objects.assign(scene.object_cnt, GLObject{});
+	camera_obj = objects.size();
+	for (uint32_t o = 0; o < scene.object_cnt; ++o)
+	{
+		GLObject& object = objects[o];
+		object.color = glm::make_vec3(scene.color + 3 * static_cast<size_t>(o));
+		object.scaling = glm::make_vec2(scene.scaling + 2 * static_cast<size_t>(o));
+		object.orientation = glm::make_vec2(scene.orientation + 2 * static_cast<size_t>(o));
+		object.position = glm::make_vec2(scene.position + 2 * static_cast<size_t>(o));
+		object.mdl_ref = mdl_refs[scene.model[o]];
+		object.shd_ref = shd_refs[scene.program[o]];
+		if (std::strcmp(scene.String(scene.name[o]), "Camera") == 0)
 		{
-			// shader found - reference shader
-			new_object.shd_ref = shdrpgms.find(shdrname);
+			camera_obj = o;
 		}
-
-		/* TODO: read remaining parameters of object from file:
-			- object's name
-			- RGB parameters for rendering object's model geometry
-			- scaling factors to be applied on object's model
-			- orientation factors: initial angularr orientation and angular speed
-			- object's position in game world
-		   
-		   Set data member GLApp::GLObject::mdl_ref to iterator that points to
-		   model instantiated by this object.
-		   
-		   Set data member GLApp::GLObject::shd_ref to iterator that points to
-		   shader program used by this object.
-		   
-		   insert this object to std::map container objects. */
-
-		// read color
-		std::getline(ifs, line);
-		std::istringstream line_color{ line };
-		line_color >> new_object.color.x >> new_object.color.y >> new_object.color.z;
-
-		// read scale
-		std::getline(ifs, line);
-		std::istringstream line_scale{ line };
-		line_scale >> new_object.scaling.x >> new_object.scaling.y;
-
-		// read orientation
-		std::getline(ifs, line);
-		std::istringstream line_orientation{ line };
-		line_orientation >> new_object.orientation.x >> new_object.orientation.y;
-		new_object.orientation.x *= 3.14f / 180.0f;
-		new_object.orientation.y *= 3.14f / 180.0f;
-
-		// read position
-		std::getline(ifs, line);
-		std::istringstream line_position{ line };
-		line_position >> new_object.position.x >> new_object.position.y;
-
-		// insert new_object into objects container
-		objects[object_name] = new_object;
 	}
+	if (camera_obj == objects.size())
+	{
+		std::cout << "ERROR: Scene file has no object named Camera: "
+			<< scene_filename << "\n";
+		exit(EXIT_FAILURE);
+	}
+	std::vector<BVH::AABB> bounds(objects.size());
+	for (size_t o = 0; o < objects.size(); ++o)
+	{
+		bounds[o] = objects[o].world_bounds();
+	}
+	bvh.Build(bounds);
 }
 
 void GLApp::GLObject::init()
@@ -378,7 +317,7 @@ void GLApp::GLObject::draw() const
 	shd_ref->second.SetUniform("uColor", color);
 
 	// part 4: render using glDrawElements or glDrawArrays
-	glDrawElements(mdl_ref->second.primitive_type, mdl_ref->second.draw_cnt, GL_UNSIGNED_SHORT, nullptr);
+	glDrawElements(mdl_ref->second.primitive_type, mdl_ref->second.draw_cnt, mdl_ref->second.index_type, nullptr);
 }
 
 void GLApp::GLObject::update(GLdouble delta_time)
@@ -410,11 +349,18 @@ void GLApp::GLObject::update(GLdouble delta_time)
 	//mdl_to_ndc_xform = m_extents * mdl_to_ndc_xform;
 }
 
+BVH::AABB GLApp::GLObject::world_bounds() const
+{
+	// farthest a vertex can get from position, at any angle
+	GLfloat radius = glm::length(mdl_ref->second.extent * glm::abs(scaling));
+	return { position - radius, position + radius };
+}
+
 void GLApp::Camera2D::init(GLFWwindow* window, GLObject* ptr)
 {
 	// assign address of object of type GLApp::GLObject with
-	// name "Camera" in std::map container GLApp::objects ...
-	pgo = &objects["Camera"];
+	// name "Camera" in container GLApp::objects ...
+	pgo = ptr;
 
 	// compute camera window's aspect ratio ...
 	GLsizei fb_width, fb_height;
@@ -13,6 +13,7 @@ an OpenGL context and implement a game loop.
 // Extension loader library's header must be included before GLFW's header!!!
 #include <glhelper.h>
 #include <glapp.h>
+#include <scenefile.h>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -32,7 +33,13 @@ static void cleanup();
 /*  _________________________________________________________________________ */
 /*! main
 
-@param none
+@param argc, argv
+  tutorial-4 [scene]
+    runs the scene, ../scenes/tutorial-4.scn if none is given. The scene may
+    be a text .scn file or a compiled one.
+  tutorial-4 -compile <scene.scn> <compiled>
+    compiles a scene and the meshes of its models into one binary file, then
+    exits without opening a window.
 
 @return int
 
@@ -40,7 +47,19 @@ Indicates how the program existed. Normal exit is signaled by a return value of
 0. Abnormal termination is signaled by a non-zero return value.
 Note that the C++ compiler will insert a return 0 statement if one is missing.
 */
-int main() {
+int main(int argc, char* argv[]) {
+  // Part 0: scene compiler
+  if (argc > 1 && std::string(argv[1]) == "-compile") {
+    if (argc != 4) {
+      std::cout << "usage: tutorial-4 -compile <scene.scn> <compiled>" << std::endl;
+      return EXIT_FAILURE;
+    }
+    return SceneFile::Compile(argv[2], argv[3]) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if (argc > 1) {
+    GLApp::scene_filename = argv[1];
+  }
+
   // Part 1
   init();
 
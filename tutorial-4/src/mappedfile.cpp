@@ -0,0 +1,161 @@
+/* !
+@file    mappedfile.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of member functions of class MappedFile
+declared in mappedfile.h, on top of CreateFileMapping on Windows and mmap
+everywhere else.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <mappedfile.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*!
+ * @brief ___MappedFile::Open___
+ * ****************************************************************************************************
+ * Maps a whole file, unmapping whatever was mapped before.
+ * ****************************************************************************************************
+ * @param path
+ * : Path of the file.
+ * @return bool
+ * : False if the file could not be opened or mapped. An empty file opens
+ * with no data.
+ * ****************************************************************************************************
+*/
+bool MappedFile::Open(std::string const& path)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	file = handle;
+	LARGE_INTEGER bytes;
+	if (!GetFileSizeEx(handle, &bytes) || static_cast<unsigned long long>(bytes.QuadPart) > SIZE_MAX)
+	{
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(bytes.QuadPart);
+	if (size == 0)
+	{
+		return true;
+	}
+	mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		Close();
+		return false;
+	}
+	data = static_cast<unsigned char const*>(view);
+#else
+	fd = open(path.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0)
+	{
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(st.st_size);
+	if (size == 0)
+	{
+		return true;
+	}
+	void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (view == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+	data = static_cast<unsigned char const*>(view);
+#endif
+	return true;
+}
+
+/*!
+ * @brief ___MappedFile::Close___
+ * ****************************************************************************************************
+ * Unmaps the file and closes it.
+ * ****************************************************************************************************
+*/
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data)
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mapping)
+	{
+		CloseHandle(mapping);
+	}
+	if (file)
+	{
+		CloseHandle(file);
+	}
+	mapping = file = nullptr;
+#else
+	if (data)
+	{
+		munmap(const_cast<unsigned char*>(data), size);
+	}
+	if (fd >= 0)
+	{
+		close(fd);
+	}
+	fd = -1;
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+/*!
+ * @brief ___MappedFile::Stat___
+ * ****************************************************************************************************
+ * Size and last modification time of a file, without opening it.
+ * ****************************************************************************************************
+ * @param path
+ * : Path of the file.
+ * @param bytes, mtime
+ * : Set to the size and the modification time, seconds since 1970.
+ * @return bool
+ * : False if there is no such file.
+ * ****************************************************************************************************
+*/
+bool MappedFile::Stat(std::string const& path, uint64_t& bytes, int64_t& mtime)
+{
+#ifdef _WIN32
+	struct _stat64 st;
+	if (_stat64(path.c_str(), &st) != 0)
+	{
+		return false;
+	}
+#else
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0)
+	{
+		return false;
+	}
+#endif
+	bytes = static_cast<uint64_t>(st.st_size);
+	mtime = static_cast<int64_t>(st.st_mtime);
+	return true;
+}
@@ -0,0 +1,640 @@
+/* !
+@file    scenefile.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the functions declared in scenefile.h
+that parse text scenes and meshes, and write and map compiled scenes.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <scenefile.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace SceneFile
+{
+	static char const magic[8] = { 'G', 'L', 'S', 'C', 'E', 'N', 'E', '1' };
+
+	// rounds bytes up to a multiple of alignment
+	static uint64_t Align(uint64_t bytes)
+	{
+		return (bytes + alignment - 1) / alignment * alignment;
+	}
+
+	// bytes of an array of a compiled scene with the given header
+	static uint64_t ArrayBytes(Header const& header, uint32_t array)
+	{
+		switch (array)
+		{
+		case ObjectColor:		return header.object_cnt * 3ull * sizeof(float);
+		case ObjectScaling:
+		case ObjectOrientation:
+		case ObjectPosition:	return header.object_cnt * 2ull * sizeof(float);
+		case ObjectModel:
+		case ObjectProgram:
+		case ObjectName:		return header.object_cnt * 1ull * sizeof(uint32_t);
+		case Models:			return header.model_cnt * 1ull * sizeof(Model);
+		case Programs:			return header.program_cnt * 1ull * sizeof(Program);
+		case Vertices:			return header.vertex_cnt * 2ull * sizeof(float);
+		case Indices16:			return header.index16_cnt * 1ull * sizeof(GLushort);
+		case Indices32:			return header.index32_cnt * 1ull * sizeof(GLuint);
+		default:				return header.string_size;
+		}
+	}
+
+	/*!
+	 * @brief ___SceneFile::Lines___
+	 * *******************************
+	 * Cursor over the lines of a NUL-terminated text.
+	*/
+	struct Lines
+	{
+		char const* next;
+		char const* end;
+
+		// sets [begin, stop) to the next line, false past the last line
+		bool Next(char const*& begin, char const*& stop)
+		{
+			if (next == end)
+			{
+				return false;
+			}
+			begin = next;
+			stop = static_cast<char const*>(std::memchr(next, '\n', end - next));
+			stop = stop ? stop : end;
+			next = stop == end ? end : stop + 1;
+			return true;
+		}
+	};
+
+	// next whitespace-separated word of [begin, stop), begin is moved past it
+	static std::string Word(char const*& begin, char const* stop)
+	{
+		while (begin != stop && std::isspace(static_cast<unsigned char>(*begin)))
+		{
+			++begin;
+		}
+		char const* word = begin;
+		while (begin != stop && !std::isspace(static_cast<unsigned char>(*begin)))
+		{
+			++begin;
+		}
+		return std::string(word, begin);
+	}
+
+	/*!
+	 * @brief ___SceneFile::Floats___
+	 * *******************************
+	 * Reads up to count numbers from the start of [begin, stop), as the
+	 * stream extractions it replaces did: reading stops at the first word
+	 * that is not a number, and numbers that are not there are 0.
+	*/
+	static void Floats(char const* begin, char const* stop, float* out, int count)
+	{
+		std::fill(out, out + count, 0.f);
+		for (int i = 0; i < count; ++i)
+		{
+			char* end;
+			float value = std::strtof(begin, &end);
+			// strtof() skips line breaks, a number on a later line is not read
+			if (end == begin || end > stop)
+			{
+				return;
+			}
+			out[i] = value;
+			begin = end;
+		}
+	}
+
+	// appends a NUL-terminated string to strings, returns its offset
+	static uint32_t AddString(std::string& strings, std::string const& s)
+	{
+		uint32_t offset = static_cast<uint32_t>(strings.size());
+		strings.append(s.c_str(), s.size() + 1);
+		return offset;
+	}
+
+	/*!
+	 * @brief ___SceneFile::ReadText___
+	 * *******************************
+	 * Contents of a file, false if it could not be mapped.
+	*/
+	static bool ReadText(std::string const& path, std::string& text)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+		text.assign(reinterpret_cast<char const*>(file.GetData()), file.GetSize());
+		return true;
+	}
+
+	/*!
+	 * @brief ___SceneFile::ParseMesh___
+	 * ****************************************************************************************************
+	 * Reads ../meshes/<name>.msh into the vertex and index arrays of a scene:
+	 * n lines name the mesh, v lines hold vertex positions, t lines hold
+	 * indices of GL_TRIANGLES and f lines indices of a GL_TRIANGLE_FAN.
+	 * The indices are 16-bit unless the mesh has more than 65536 vertices.
+	 * ****************************************************************************************************
+	 * @return bool
+	 * : False, after printing why, if the mesh could not be read or an index
+	 * is not one of its vertices.
+	 * ****************************************************************************************************
+	*/
+	static bool ParseMesh(std::string const& name, Scene& scene, Model& model)
+	{
+		std::string text;
+		if (!ReadText("../meshes/" + name + ".msh", text))
+		{
+			std::cout << "ERROR: Unable to open mesh file: " << name << "\n";
+			return false;
+		}
+
+		size_t first_float = scene.vertices.size();
+		model.primitive_type = 0;
+		std::vector<uint32_t> indices;
+		Lines lines{ text.c_str(), text.c_str() + text.size() };
+		char const* begin, * stop;
+		while (lines.Next(begin, stop))
+		{
+			while (begin != stop && std::isspace(static_cast<unsigned char>(*begin)))
+			{
+				++begin;
+			}
+			if (begin == stop)
+			{
+				continue;
+			}
+			char c = *begin++;
+			if (c == 'v')
+			{
+				for (;;)
+				{
+					char* end;
+					double vertex = std::strtod(begin, &end);
+					if (end == begin || end > stop)
+					{
+						break;
+					}
+					scene.vertices.push_back(static_cast<float>(vertex));
+					begin = end;
+				}
+			}
+			else if (c == 't' || c == 'f')
+			{
+				for (;;)
+				{
+					char* end;
+					long index = std::strtol(begin, &end, 10);
+					if (end == begin || end > stop)
+					{
+						break;
+					}
+					indices.push_back(static_cast<uint32_t>(index));
+					begin = end;
+				}
+				model.primitive_type = c == 't' ? GL_TRIANGLES : GL_TRIANGLE_FAN;
+			}
+		}
+		// vertices are pairs of floats, an odd one out is paired with 0
+		if ((scene.vertices.size() - first_float) % 2 != 0)
+		{
+			scene.vertices.push_back(0.f);
+		}
+
+		model.first_vertex = static_cast<uint32_t>(first_float / 2);
+		model.vertex_cnt = static_cast<uint32_t>((scene.vertices.size() - first_float) / 2);
+		model.index_cnt = static_cast<uint32_t>(indices.size());
+		for (uint32_t index : indices)
+		{
+			if (index >= model.vertex_cnt)
+			{
+				std::cout << "ERROR: Mesh " << name << " has index " << static_cast<int32_t>(index)
+					<< " but only " << model.vertex_cnt << " vertices\n";
+				return false;
+			}
+		}
+		if (model.vertex_cnt > std::numeric_limits<GLushort>::max() + 1u)
+		{
+			model.index_type = GL_UNSIGNED_INT;
+			model.first_index = static_cast<uint32_t>(scene.indices32.size());
+			scene.indices32.insert(scene.indices32.end(), indices.begin(), indices.end());
+		}
+		else
+		{
+			model.index_type = GL_UNSIGNED_SHORT;
+			model.first_index = static_cast<uint32_t>(scene.indices16.size());
+			scene.indices16.insert(scene.indices16.end(), indices.begin(), indices.end());
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief ___Scene::GetView___
+	 * *******************************
+	 * View of the scene's arrays, valid until the scene changes.
+	*/
+	View Scene::GetView() const
+	{
+		View view;
+		view.object_cnt = static_cast<uint32_t>(model.size());
+		view.model_cnt = static_cast<uint32_t>(models.size());
+		view.program_cnt = static_cast<uint32_t>(programs.size());
+		view.vertex_cnt = static_cast<uint32_t>(vertices.size() / 2);
+		view.index16_cnt = static_cast<uint32_t>(indices16.size());
+		view.index32_cnt = static_cast<uint32_t>(indices32.size());
+		view.string_size = static_cast<uint32_t>(strings.size());
+		view.color = color.data();
+		view.scaling = scaling.data();
+		view.orientation = orientation.data();
+		view.position = position.data();
+		view.model = model.data();
+		view.program = program.data();
+		view.name = name.data();
+		view.models = models.data();
+		view.programs = programs.data();
+		view.vertices = vertices.data();
+		view.indices16 = indices16.data();
+		view.indices32 = indices32.data();
+		view.strings = strings.data();
+		return view;
+	}
+
+	/*!
+	 * @brief ___SceneFile::IsCompiled___
+	 * *******************************
+	 * True if bytes start like a compiled scene, which may still be invalid.
+	*/
+	bool IsCompiled(unsigned char const* bytes, size_t size)
+	{
+		return size >= sizeof(magic) && std::memcmp(bytes, magic, sizeof(magic)) == 0;
+	}
+
+	/*!
+	 * @brief ___SceneFile::Parse___
+	 * ****************************************************************************************************
+	 * Parses a text scene and reads the .msh file of each of its models.
+	 * Objects sharing a name are one object, the last one.
+	 * ****************************************************************************************************
+	 * @param text
+	 * : Contents of the .scn file.
+	 * @param scene
+	 * : Empty scene to parse into.
+	 * @return bool
+	 * : False, after printing why, if the text is cut short or a mesh could
+	 * not be read.
+	 * ****************************************************************************************************
+	*/
+	bool Parse(std::string const& text, Scene& scene)
+	{
+		Lines lines{ text.c_str(), text.c_str() + text.size() };
+		char const* begin, * stop;
+
+		// object count
+		long obj_cnt = 0;
+		if (lines.Next(begin, stop))
+		{
+			char* end;
+			obj_cnt = std::strtol(begin, &end, 10);
+			obj_cnt = end > stop ? 0 : obj_cnt;
+		}
+		if (obj_cnt < 0)
+		{
+			std::cout << "ERROR: Scene has " << obj_cnt << " objects\n";
+			return false;
+		}
+
+		// objects in file order, with the models and shader programs they
+		// bring in; an object takes 7 lines, which bounds the reservation
+		std::vector<std::string> names;
+		std::vector<float> color, scaling, orientation, position;
+		std::vector<uint32_t> model, program;
+		size_t reserve = std::min(static_cast<size_t>(obj_cnt), text.size() / 7);
+		names.reserve(reserve);
+		model.reserve(reserve);
+		program.reserve(reserve);
+		color.reserve(reserve * 3);
+		scaling.reserve(reserve * 2);
+		orientation.reserve(reserve * 2);
+		position.reserve(reserve * 2);
+		std::map<std::string, uint32_t> model_ids, program_ids;
+
+		for (long o = 0; o < obj_cnt; ++o)
+		{
+			char const* line[7][2];
+			for (int l = 0; l < 7; ++l)
+			{
+				if (!lines.Next(line[l][0], line[l][1]))
+				{
+					std::cout << "ERROR: Scene ends after " << o << " of " << obj_cnt << " objects\n";
+					return false;
+				}
+			}
+
+			// model, read from its mesh the first time it is used
+			std::string model_name = Word(line[0][0], line[0][1]);
+			auto m = model_ids.find(model_name);
+			if (m == model_ids.end())
+			{
+				Model new_model;
+				new_model.name = AddString(scene.strings, model_name);
+				if (!ParseMesh(model_name, scene, new_model))
+				{
+					return false;
+				}
+				m = model_ids.emplace(model_name, static_cast<uint32_t>(scene.models.size())).first;
+				scene.models.push_back(new_model);
+			}
+			model.push_back(m->second);
+
+			names.push_back(Word(line[1][0], line[1][1]));
+
+			// shader program, named by the first object that uses it
+			std::string shdr_name = Word(line[2][0], line[2][1]);
+			std::string vert_file = Word(line[2][0], line[2][1]);
+			std::string frag_file = Word(line[2][0], line[2][1]);
+			auto p = program_ids.find(shdr_name);
+			if (p == program_ids.end())
+			{
+				Program new_program;
+				new_program.name = AddString(scene.strings, shdr_name);
+				new_program.vertex_shader = AddString(scene.strings, vert_file);
+				new_program.fragment_shader = AddString(scene.strings, frag_file);
+				p = program_ids.emplace(shdr_name, static_cast<uint32_t>(scene.programs.size())).first;
+				scene.programs.push_back(new_program);
+			}
+			program.push_back(p->second);
+
+			float values[3];
+			Floats(line[3][0], line[3][1], values, 3);
+			color.insert(color.end(), values, values + 3);
+			Floats(line[4][0], line[4][1], values, 2);
+			scaling.insert(scaling.end(), values, values + 2);
+			// orientation is given in degrees
+			Floats(line[5][0], line[5][1], values, 2);
+			values[0] *= 3.14f / 180.0f;
+			values[1] *= 3.14f / 180.0f;
+			orientation.insert(orientation.end(), values, values + 2);
+			Floats(line[6][0], line[6][1], values, 2);
+			position.insert(position.end(), values, values + 2);
+		}
+
+		// objects are kept sorted by name, the order GLApp has always drawn
+		// them in, and of objects sharing a name only the last one is kept
+		std::vector<uint32_t> order(names.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			uint32_t o = order[i];
+			if (i + 1 < order.size() && names[order[i + 1]] == names[o])
+			{
+				continue;
+			}
+			scene.name.push_back(AddString(scene.strings, names[o]));
+			scene.model.push_back(model[o]);
+			scene.program.push_back(program[o]);
+			scene.color.insert(scene.color.end(), &color[3 * o], &color[3 * o] + 3);
+			scene.scaling.insert(scene.scaling.end(), &scaling[2 * o], &scaling[2 * o] + 2);
+			scene.orientation.insert(scene.orientation.end(), &orientation[2 * o], &orientation[2 * o] + 2);
+			scene.position.insert(scene.position.end(), &position[2 * o], &position[2 * o] + 2);
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief ___SceneFile::Map___
+	 * ****************************************************************************************************
+	 * Points a view at the arrays of a compiled scene, nothing is copied.
+	 * ****************************************************************************************************
+	 * @param file
+	 * : Mapping of the compiled scene, which must stay open while the view
+	 * is used.
+	 * @param view
+	 * : Set to the scene's arrays.
+	 * @return bool
+	 * : False, after printing why, if the file is not a compiled scene this
+	 * build can read, or refers to anything outside its arrays.
+	 * ****************************************************************************************************
+	*/
+	bool Map(MappedFile const& file, View& view)
+	{
+		Header header;
+		if (file.GetSize() < sizeof(Header))
+		{
+			std::cout << "ERROR: Compiled scene is cut short\n";
+			return false;
+		}
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+			header.header_size != sizeof(Header))
+		{
+			std::cout << "ERROR: Compiled scene is version " << header.version << ", expected " << version
+				<< ", compile it again\n";
+			return false;
+		}
+		for (uint32_t a = 0; a < ArrayCount; ++a)
+		{
+			if (header.offset[a] % alignment != 0 || header.offset[a] > file.GetSize() ||
+				ArrayBytes(header, a) > file.GetSize() - header.offset[a])
+			{
+				std::cout << "ERROR: Compiled scene is cut short\n";
+				return false;
+			}
+		}
+
+		auto at = [&](uint32_t array) { return file.GetData() + header.offset[array]; };
+		view.object_cnt = header.object_cnt;
+		view.model_cnt = header.model_cnt;
+		view.program_cnt = header.program_cnt;
+		view.vertex_cnt = header.vertex_cnt;
+		view.index16_cnt = header.index16_cnt;
+		view.index32_cnt = header.index32_cnt;
+		view.string_size = header.string_size;
+		view.color = reinterpret_cast<float const*>(at(ObjectColor));
+		view.scaling = reinterpret_cast<float const*>(at(ObjectScaling));
+		view.orientation = reinterpret_cast<float const*>(at(ObjectOrientation));
+		view.position = reinterpret_cast<float const*>(at(ObjectPosition));
+		view.model = reinterpret_cast<uint32_t const*>(at(ObjectModel));
+		view.program = reinterpret_cast<uint32_t const*>(at(ObjectProgram));
+		view.name = reinterpret_cast<uint32_t const*>(at(ObjectName));
+		view.models = reinterpret_cast<Model const*>(at(Models));
+		view.programs = reinterpret_cast<Program const*>(at(Programs));
+		view.vertices = reinterpret_cast<float const*>(at(Vertices));
+		view.indices16 = reinterpret_cast<GLushort const*>(at(Indices16));
+		view.indices32 = reinterpret_cast<GLuint const*>(at(Indices32));
+		view.strings = reinterpret_cast<char const*>(at(Strings));
+
+		// every index must stay within its array, and every string within
+		// the NUL-terminated string table
+		bool valid = view.string_size == 0 || view.strings[view.string_size - 1] == '\0';
+		for (uint32_t m = 0; valid && m < view.model_cnt; ++m)
+		{
+			Model const& model = view.models[m];
+			bool wide = model.index_type == GL_UNSIGNED_INT;
+			valid = model.name < view.string_size &&
+				model.first_vertex + static_cast<uint64_t>(model.vertex_cnt) <= view.vertex_cnt &&
+				(wide || model.index_type == GL_UNSIGNED_SHORT) &&
+				model.first_index + static_cast<uint64_t>(model.index_cnt) <= (wide ? view.index32_cnt : view.index16_cnt);
+			for (uint32_t i = 0; valid && i < model.index_cnt; ++i)
+			{
+				uint32_t index = wide ? view.indices32[model.first_index + i] : view.indices16[model.first_index + i];
+				valid = index < model.vertex_cnt;
+			}
+		}
+		for (uint32_t p = 0; valid && p < view.program_cnt; ++p)
+		{
+			Program const& program = view.programs[p];
+			valid = program.name < view.string_size && program.vertex_shader < view.string_size &&
+				program.fragment_shader < view.string_size;
+		}
+		for (uint32_t o = 0; valid && o < view.object_cnt; ++o)
+		{
+			valid = view.model[o] < view.model_cnt && view.program[o] < view.program_cnt &&
+				view.name[o] < view.string_size;
+		}
+		if (!valid)
+		{
+			std::cout << "ERROR: Compiled scene refers to data it does not hold\n";
+			return false;
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief ___SceneFile::Load___
+	 * ****************************************************************************************************
+	 * Views a scene file of either kind: a compiled scene is mapped, a text
+	 * scene is parsed into scene.
+	 * ****************************************************************************************************
+	 * @param file
+	 * : Mapping of the scene file, which must stay open while the view is
+	 * used.
+	 * @param scene
+	 * : Empty scene to parse a text scene into, which must outlive the view.
+	 * @param view
+	 * : Set to the scene's arrays.
+	 * @return bool
+	 * : False, after printing why, if Parse() or Map() failed.
+	 * ****************************************************************************************************
+	*/
+	bool Load(MappedFile const& file, Scene& scene, View& view)
+	{
+		if (IsCompiled(file.GetData(), file.GetSize()))
+		{
+			return Map(file, view);
+		}
+		std::string text;
+		if (file.GetSize())
+		{
+			text.assign(reinterpret_cast<char const*>(file.GetData()), file.GetSize());
+		}
+		if (!Parse(text, scene))
+		{
+			return false;
+		}
+		view = scene.GetView();
+		return true;
+	}
+
+	/*!
+	 * @brief ___SceneFile::Compile___
+	 * ****************************************************************************************************
+	 * Compiles a text scene and its meshes into a single binary file.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the .scn file, or of a compiled scene to rewrite.
+	 * @param destination
+	 * : Path of the compiled scene to write.
+	 * @return bool
+	 * : False, after printing why, if the scene could not be read or the
+	 * compiled scene could not be written.
+	 * ****************************************************************************************************
+	*/
+	bool Compile(std::string const& source, std::string const& destination)
+	{
+		// the whole file is put together in memory first, so source may be
+		// unmapped before destination, which may be the same file, is written
+		std::vector<unsigned char> bytes;
+		{
+			MappedFile file;
+			if (!file.Open(source))
+			{
+				std::cout << "ERROR: Unable to open scene file: " << source << "\n";
+				return false;
+			}
+			Scene scene;
+			View view;
+			if (!Load(file, scene, view))
+			{
+				return false;
+			}
+
+			Header header{};
+			std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			header.header_size = sizeof(Header);
+			header.object_cnt = view.object_cnt;
+			header.model_cnt = view.model_cnt;
+			header.program_cnt = view.program_cnt;
+			header.vertex_cnt = view.vertex_cnt;
+			header.index16_cnt = view.index16_cnt;
+			header.index32_cnt = view.index32_cnt;
+			header.string_size = view.string_size;
+			uint64_t end = Align(sizeof(Header));
+			for (uint32_t a = 0; a < ArrayCount; ++a)
+			{
+				header.offset[a] = end;
+				end = Align(end + ArrayBytes(header, a));
+			}
+
+			void const* arrays[ArrayCount] = {
+				view.color, view.scaling, view.orientation, view.position,
+				view.model, view.program, view.name,
+				view.models, view.programs, view.vertices, view.indices16, view.indices32, view.strings
+			};
+			bytes.assign(static_cast<size_t>(end), 0);
+			std::memcpy(bytes.data(), &header, sizeof(Header));
+			for (uint32_t a = 0; a < ArrayCount; ++a)
+			{
+				if (ArrayBytes(header, a))
+				{
+					std::memcpy(bytes.data() + header.offset[a], arrays[a], static_cast<size_t>(ArrayBytes(header, a)));
+				}
+			}
+		}
+
+		// written under another name first, so a compiled scene is never
+		// seen half written
+		std::string temp = destination + ".tmp";
+		{
+			std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file || !file.write(reinterpret_cast<char const*>(bytes.data()), bytes.size()))
+			{
+				std::cout << "ERROR: Unable to write compiled scene: " << destination << "\n";
+				return false;
+			}
+		}
+		std::remove(destination.c_str());
+		if (std::rename(temp.c_str(), destination.c_str()) != 0)
+		{
+			std::cout << "ERROR: Unable to write compiled scene: " << destination << "\n";
+			std::remove(temp.c_str());
+			return false;
+		}
+		return true;
+	}
+}
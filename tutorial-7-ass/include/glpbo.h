@@ -63,6 +63,11 @@ texture image store.
 5) In the game loop's draw(), you go thro' the regular process of rendering
 a textured quad with the texture object whose texture memory was updated in
 the previous step. This is done by calling GLPbo::draw_fullwindow_quad().
+
+The members above that need OpenGL, vaoid, elem_cnt, pboid, texid, shdr_pgm,
+setup_quad_vao() and setup_shdrpgm(), have since moved to GLPboDisplay in
+glpbodisplay.h, which only glpbo.cpp includes. What is left here builds
+without GLEW, so the headless renderer and benchmark need no OpenGL at all.
 *//*__________________________________________________________________________*/
 
 /*                                                                      guard
@@ -72,8 +77,14 @@ the previous step. This is done by calling GLPbo::draw_fullwindow_quad().
 
 /*                                                                   includes
 ----------------------------------------------------------------------------- */
-#include <GL/glew.h> // for access to OpenGL API declarations 
-#include <glslshader.h> // GLSLShader class definition
+#include <gltypes.h> // GLuint and friends, without the OpenGL API
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class RenderTarget; // rendertarget.h
+class ThreadPool; // threadpool.h
 
 /*  _________________________________________________________________________ */
 struct GLPbo
@@ -87,6 +98,9 @@ struct GLPbo
   union Color;
 
   //-------------- static member function declarations here -----------------
+
+  // emulate() to cleanup() need a GL context and are defined in glpbo.cpp,
+  // only the windowed application links them
   
   // this is where the emulator does its work of emulating the graphics pipe
   // it generates images using set_pixel to write to the PBO
@@ -95,12 +109,27 @@ struct GLPbo
   // render quad using the texture image generated by render()
   static void draw_fullwindow_quad();
 
+  // average time per frame, in milliseconds, that emulate() spent waiting
+  // for the GPU to finish reading the next PBO of the ring
+  static double fence_wait_ms();
+
   // initialization and cleanup stuff ...
   static void init(GLsizei w, GLsizei h);
-  static void setup_quad_vao();
-  static void setup_shdrpgm();
   static void cleanup();
 
+  // OpenGL free part of init() and cleanup(), enough to draw into a
+  // HostRenderTarget without a GL context
+  static void init_rasterizer(GLsizei w, GLsizei h);
+  static void cleanup_rasterizer();
+
+  // the rasterizer's worker threads, free for other work between frames,
+  // null outside of init_rasterizer() and cleanup_rasterizer()
+  static ThreadPool* rasterizer_workers();
+
+  // draws one frame of the current scene into a width x height render target,
+  // ptr_to_pbo points to the target's pixels while the frame is drawn
+  static void render_scene(RenderTarget& target);
+
   // ---------------static data members are declared here ----------------
   
   // Storage requirements common to emulator, PBO and texture object
@@ -109,17 +138,9 @@ struct GLPbo
   // GLPbo::init() and then forget ...
   static GLsizei pixel_cnt, byte_cnt; // how many pixels and bytes
   // pointer to PBO's memory chunk - must be set every frame with the value 
-  // returned by glMapNamedBuffer()
+  // returned by glMapNamedBuffer(), or more generally RenderTarget::Map()
   static Color *ptr_to_pbo;
 
-  // geometry and material information ...
-  static GLuint vaoid;        // with GL 4.5, VBO & EBO are not required
-  static GLuint elem_cnt;     // how many indices in element buffer
-  static GLuint pboid;        // id for PBO
-  static GLuint texid;        // id for texture object
-  static GLSLShader shdr_pgm; // object that abstracts away nitty-gritty
-                              // details of shader management
-
 // --- here we're trying to emulate GL's functions for clearing colorbuffer ---
 
   // overloaded functions akin to glClearcolor that set GLPbo::clear_clr
@@ -150,44 +171,105 @@ struct GLPbo
       r(re), g(gr), b(bl), a(al) {}
   };
   
+  /*!
+   * @brief ___Pbo::Meshlet___
+   * ****************************************************************************************************
+   * A run of consecutive triangles of a model, bounded so draw_elements()
+   * can reject it as a whole, see MeshOpt::BuildMeshlets().
+   * ****************************************************************************************************
+  */
+  struct Meshlet
+  {
+      glm::vec3   center{ 0.f };          /*!< bounding sphere of the positions its triangles use */
+      float       radius{ 0.f };
+      glm::vec3   cone_axis{ 0.f };       /*!< unit axis of a cone around every triangle normal */
+      float       cone_cos{ -1.f };       /*!< of the cone's half angle, not above 0 when no cone under 90 degrees exists */
+      float       cone_sin{ 0.f };
+      GLuint      first_triangle{ 0 }, triangle_cnt{ 0 };
+      GLuint      first_vertex{ 0 }, vertex_cnt{ 0 };   /*!< every vertex its triangles use lies in this range */
+  };
+
   /*!
    * @brief ___Pbo::Model___
    * ****************************************************************************************************
-   * Describes the model data returned by DPML::parse_obj_mesh()
+   * Describes the model data returned by DPML::parse_obj_mesh(). The
+   * triangle indices are 16-bit while every vertex fits, and 32-bit in
+   * tri32 otherwise, only one of tri and tri32 is ever filled.
    * ****************************************************************************************************
   */
   struct Model
   {
       std::vector<glm::vec3>        pm;     /*!< vertex positions */
       std::vector<glm::vec3>        nml;    /*!< per vertex normal coordinates */
-      std::vector<glm::vec2>        tex;    /*!< not used */
-      std::vector<unsigned short>   tri;    /*!< triangle indices */
-      std::vector<glm::vec3>        pd;     /*!< window coordinates after transforming pm by rotation then viewport transformation matrix */
+      std::vector<glm::vec2>        tex;    /*!< per vertex texture coordinates */
+      std::vector<unsigned short>   tri;    /*!< triangle indices of models with up to 65536 vertices */
+      std::vector<GLuint>           tri32;  /*!< triangle indices of larger models */
+      std::vector<Meshlet>          meshlets;   /*!< covering every triangle in order, or empty to draw them all */
+
+      // vertex stage buffers in structure of arrays form, padded to a
+      // multiple of SIMD::width and kept from frame to frame
+      std::vector<float>            px, py, pz;         /*!< pm, copied by transform_vertices() when pm changes size */
+      std::vector<float>            xc, yc, zc, wc;     /*!< clip coordinates */
+      std::vector<float>            xd, yd, zd;         /*!< window coordinates, only meaningful where clip is 0 */
+      std::vector<float>            qd;                 /*!< 1 / w, the perspective divide's scale */
+      std::vector<unsigned char>    clip;               /*!< clip_near | clip_far bits of each vertex */
+
+      // window coordinates of vertex i
+      glm::vec3 window(GLuint i) const { return { xd[i], yd[i], zd[i] }; }
+
+      // how many triangles the model has, whatever its index width
+      size_t triangle_cnt() const { return (tri32.empty() ? tri.size() : tri32.size()) / 3; }
+
+      // sets the triangle indices, narrowed to tri when pm is small enough
+      // for 16 bits, moved to tri32 otherwise
+      void set_triangles(std::vector<GLuint>&& indices);
+
+      // calls f with a pointer to the triangle indices, unsigned short or
+      // GLuint, so index loops are compiled once per width
+      template <typename F>
+      void visit_triangles(F&& f) const
+      {
+        if (tri32.empty())
+          f(tri.data());
+        else
+          f(tri32.data());
+      }
   };
   static Model cube;
 
  /*!
-* @brief ___viewport_xform___
+* @brief ___transform_vertices___
  * ****************************************************************************************************
- * Transformation that applies rotation and a viewport transform to all
- * vertices of a specified model.
+ * Vertex stage: transforms every vertex of a model by a model view
+ * projection matrix into clip coordinates, classifies them against the
+ * near and far planes, then does the perspective divide and maps x and y
+ * to the viewport. z in [-1, 1] is mapped to depth in [0, 1] like
+ * glDepthRange(0, 1), nearer vertices get smaller depths. SIMD::width
+ * vertices are transformed per instruction, and once the model's buffers
+ * have grown to size no frame allocates.
  * ****************************************************************************************************
  * @param model
  * : Model to transform.
+ * @param mvp
+ * : Model view projection matrix.
  * ****************************************************************************************************
 */
-  static void viewport_xform(Model& model);
+  static void transform_vertices(Model& model, glm::mat4 const& mvp);
+
+  // transforms vertices [first, first + count) of a model, and the others
+  // sharing their SIMD registers, as transform_vertices() does
+  static void transform_vertices(Model& model, glm::mat4 const& mvp, size_t first, size_t count);
 
   /*!
  * @brief ___set_pixel___
  * ****************************************************************************************************
- * Does scizzoring check and sets a color into the specified location
- * in the pbo.
+ * Sets a color into the specified location in the pbo and flags its
+ * tile as drawn. Does no scissoring, callers clip to the viewport.
  * ****************************************************************************************************
  * @param x
- * : x-coordinate.
+ * : x-coordinate in [0, width).
  * @param y
- * : y-coordinate.
+ * : y-coordinate in [0, height).
  * @param draw_clr
  * : Color to set the pixel to.
  * ****************************************************************************************************
@@ -277,6 +359,397 @@ struct GLPbo
   static bool render_triangle(glm::vec3 const& p0, glm::vec3 const& p1,
       glm::vec3 const& p2, glm::vec3 const& c0,
       glm::vec3 const& c1, glm::vec3 const& c2);
+
+  // --- varyings ---
+
+  // most float attributes a vertex can pass on to the pixels of its
+  // triangles, e.g. a color, texture coordinates and a normal
+  static constexpr int max_varyings = 8;
+
+  /*!
+   * @brief ___Pbo::Vertex___
+   * ****************************************************************************************************
+   * A vertex after the perspective divide. Varyings are stored divided by w
+   * like 1/w itself, since those are what vary linearly in screen space.
+   * Vertices that never had a w keep q = 1 and their varyings as they are.
+   * ****************************************************************************************************
+  */
+  struct Vertex
+  {
+      glm::vec3   p;                          /*!< window coordinates */
+      GLfloat     q = 1.f;                    /*!< 1 / w */
+      GLfloat     v[max_varyings] = {};       /*!< varyings / w */
+  };
+
+  /*!
+ * @brief ___render_triangle___
+ * ****************************************************************************************************
+ * Renders a triangle with a shader, see shaders.h. Its pixels get the
+ * first Shader::varyings varyings of its vertices interpolated
+ * perspective-correctly. With GLPbo::tiled set, the shader is copied until
+ * resolve_tiles(), anything it points to must stay alive until then.
+ * ****************************************************************************************************
+ * @param v0, v1, v2
+ * : Vertices of the triangle.
+ * @param shader
+ * : Shader and its uniforms.
+ * @param face
+ * : Flat color of the triangle, only used by shaders without varyings.
+ * @return bool
+ * : If triangle was successfully rendered. I.e. not backface-culled.
+ * ****************************************************************************************************
+*/
+  template <typename Shader>
+  static bool render_triangle(Vertex const& v0, Vertex const& v1, Vertex const& v2, Shader const& shader, Color face = Color());
+
+  /*!
+ * @brief ___render_triangle_wireframe___
+ * ****************************************************************************************************
+ * Same as the overload above for the triangle (i0, i1, i2) of a model
+ * that went through transform_vertices(). Triangles crossing the near or
+ * far plane are clipped in clip coordinates first.
+ * ****************************************************************************************************
+*/
+  static bool render_triangle_wireframe(Model const& model, GLuint i0, GLuint i1, GLuint i2, const GLPbo::Color& clr);
+
+  // --- texture unit ---
+
+  /*!
+   * @brief ___Pbo::Texture___
+   * ****************************************************************************************************
+   * An RGBA8 texture with its mip chain, sampled with GL_REPEAT wrapping by
+   * the shaders in shaders.h. Sizes must be powers of two. All levels
+   * share one allocation. The level tables are plain int32 arrays, so the
+   * sampler can look up a different level per pixel with a SIMD gather.
+   * Minified textures read from a level whose texels are about one pixel
+   * apart. Without mips, neighbouring pixels would read texels far apart
+   * and miss the cache on every read.
+   * Levels are stored row by row as loaded, or in Morton (Z) order after
+   * set_layout(). Morton order keeps texels that are close in 2D close in
+   * memory in every direction, so a triangle rotated in screen space does
+   * not walk the texture a whole row apart per pixel.
+   * ****************************************************************************************************
+  */
+  struct Texture
+  {
+      // akin to GL_NEAREST_MIPMAP_NEAREST, GL_LINEAR_MIPMAP_NEAREST and
+      // GL_LINEAR_MIPMAP_LINEAR, a texture without mips is sampled from
+      // level 0 only
+      enum class Filter
+      {
+          Nearest,        /*!< nearest texel of the nearest level */
+          Bilinear,       /*!< 2x2 texels of the nearest level */
+          Trilinear       /*!< 2x2 texels of the two nearest levels, blended */
+      };
+
+      // order of the texels within each level
+      enum class Layout
+      {
+          Linear,         /*!< row by row, rows bottom up */
+          Morton          /*!< bits of x and y interleaved, x in the even bits, square textures only */
+      };
+
+      static constexpr int max_levels = 16;
+
+      std::vector<Color>  texels;                         /*!< every level, level 0 first */
+      Layout              layout = Layout::Linear;        /*!< order of the texels of each level */
+      GLint               levels = 0;                     /*!< levels in use */
+      int32_t             level_width[max_levels] = {};   /*!< texels per row of each level */
+      int32_t             level_height[max_levels] = {};  /*!< rows of each level */
+      int32_t             level_offset[max_levels] = {};  /*!< first texel of each level */
+      int32_t             level_xmask[max_levels] = {};   /*!< level_width - 1 spread to the even bits, wraps Morton x */
+      int32_t             level_ymask[max_levels] = {};   /*!< level_height - 1 spread to the odd bits, wraps Morton y */
+
+      /*!
+       * @brief ___Texture::load___
+       * ****************************************************************************************************
+       * Reads a w x h .tex file (raw RGBA bytes, like GLApp::setup_texobj()
+       * reads) into level 0. Any mip levels it had are dropped.
+       * ****************************************************************************************************
+       * @return bool
+       * : False, after printing why, if the file could not be read or a
+       * size is not a power of two.
+       * ****************************************************************************************************
+      */
+      bool load(std::string const& path, GLsizei w = 256, GLsizei h = 256);
+
+      // akin to glTexImage2D, makes w x h texels, row by row, level 0 of a
+      // linear texture. False, after printing why, if a size is not a power
+      // of two or image is not w * h texels
+      bool set_image(GLsizei w, GLsizei h, std::vector<Color> image);
+
+      // box filters level 0 down to 1 x 1 texel, akin to glGenerateMipmap
+      void build_mipmaps();
+
+      /*!
+       * @brief ___Texture::set_layout___
+       * ****************************************************************************************************
+       * Reorders the texels of every level, once after loading, so the
+       * sampler never converts between layouts per texel.
+       * ****************************************************************************************************
+       * @return bool
+       * : False, after printing why, for Layout::Morton on a texture that is
+       * not square. The texture keeps its layout.
+       * ****************************************************************************************************
+      */
+      bool set_layout(Layout to);
+
+      // index in texels of texel (x, y) of a level, x and y in range
+      size_t texel_index(GLint level, int32_t x, int32_t y) const;
+  };
+
+  // how draw_elements() draws a model's triangles
+  enum class DrawMode
+  {
+      Wireframe,          /*!< edges in DrawState::line_clr */
+      WireframeColor,     /*!< edges in DrawState::face_clr */
+      FlatShaded,         /*!< filled with Shaders::Flat */
+      SmoothShaded,       /*!< filled with Shaders::Gouraud */
+      NormalShaded,       /*!< filled with Shaders::Normal */
+      Textured            /*!< filled with Shaders::Textured */
+  };
+
+  /*!
+   * @brief ___Pbo::DrawState___
+   * ****************************************************************************************************
+   * Everything draw_elements() needs besides the model and the mode.
+   * face_clr is indexed like the model's triangles. It and texture are only
+   * read by the modes that use them. Models without texture coordinates,
+   * and any model when texture is null, are drawn smooth shaded in
+   * Textured mode.
+   * ****************************************************************************************************
+  */
+  struct DrawState
+  {
+      glm::mat4           mvp{ 1.f };             /*!< model view projection matrix */
+      Color               line_clr;               /*!< Wireframe edge color */
+      glm::vec3 const*    face_clr = nullptr;     /*!< one color per triangle, channels in [0, 255] */
+      Texture const*      texture = nullptr;      /*!< Textured texture */
+      Texture::Filter     filter = Texture::Filter::Trilinear;  /*!< Textured filter */
+  };
+
+  /*!
+   * @brief ___draw_elements___
+   * ****************************************************************************************************
+   * Akin to glDrawElements(GL_TRIANGLES, ...): runs a model through the
+   * vertex stage, then draws all its triangles in index order. Filled
+   * triangles are culled and classified against the viewport and guard
+   * band SIMD::width at a time, and only the survivors are set up and
+   * rasterized. With cluster_culling, whole meshlets are culled first.
+   * ****************************************************************************************************
+   * @param model
+   * : Model to draw.
+   * @param mode
+   * : How to draw its triangles.
+   * @param state
+   * : Transform and colors.
+   * ****************************************************************************************************
+  */
+  static void draw_elements(Model& model, DrawMode mode, DrawState const& state);
+
+  /*!
+   * @brief ___draw_elements___
+   * ****************************************************************************************************
+   * Same as the overload above for filled triangles drawn with a shader,
+   * see shaders.h. The shader's vertex function runs once per vertex, its
+   * fragment function is inlined into the rasterization kernels. With
+   * GLPbo::tiled set, the shader is copied until resolve_tiles(), anything
+   * it points to must stay alive until then.
+   * ****************************************************************************************************
+  */
+  template <typename Shader>
+  static void draw_elements(Model& model, Shader const& shader, glm::mat4 const& mvp);
+
+  /*!
+   * @brief ___Pbo::TriangleSetup___
+   * ****************************************************************************************************
+   * Everything render_triangle() computes once per triangle before touching
+   * any pixel. Pixels only depend on this data and their own coordinates, so
+   * a triangle can be rasterized in any order of sub-rectangles (tiles) and
+   * still produce the exact same image.
+   * ****************************************************************************************************
+  */
+  struct TriangleSetup
+  {
+      glm::vec3   l0, l1, l2;             /*!< edge equations */
+      bool        l0_tl, l1_tl, l2_tl;    /*!< precalculated top left of each edge */
+      GLint       xmin, xmax, ymin, ymax; /*!< pixel aabb, max is exclusive */
+      Color       clr;                    /*!< flat color */
+      void const* shader;                 /*!< shader the triangle is drawn with, see shaders.h */
+      void        (*rasterize)(TriangleSetup const&, GLint, GLint, GLint, GLint); /*!< rasterize_triangle() for the shader's type */
+      bool        perspective;            /*!< vertices differ in w, varyings are interpolated over w then divided by interpolated 1 / w */
+      GLfloat     k0[max_varyings];       /*!< float: shader varyings (over w) of each vertex divided by double area, */
+      GLfloat     k1[max_varyings];       /*!< v = eval0 * k0 + eval1 * k1 + eval2 * k2; fixed point: plane */
+      GLfloat     k2[max_varyings];       /*!< of each varying, v = k0 * x + (k1 * y + k2) */
+      glm::vec3   q_k;                    /*!< same as k0, k1, k2 for 1 / w */
+      bool        flipped;                /*!< back face set up as (p0, p2, p1), see backface_culling */
+      glm::vec3   z_plane;                /*!< depth, z = z_plane.x * x + (z_plane.y * y + z_plane.z) */
+      GLfloat     zmin, zmax;             /*!< depth range of the vertices, interpolated depth is clamped to it */
+
+      /*!
+       * @brief ___TriangleSetup::FixedEdge___
+       * Edge equation on vertices snapped to 28.4 fixed point,
+       * E = a * X + b * Y + c with X, Y in 1/16 pixels.
+      */
+      struct FixedEdge
+      {
+          long long   a, b, c;
+      };
+      bool        fixed;                  /*!< rasterize with f0, f1, f2 instead of l0, l1, l2 */
+      FixedEdge   f0, f1, f2;             /*!< fixed point edge equations, share l0_tl, l1_tl, l2_tl */
+  };
+
+  /*!
+   * @brief ___setup_triangle___
+   * ****************************************************************************************************
+   * Backface culls a triangle and computes its edge equations, depth plane
+   * and aabb. The aabb is clamped to the viewport, the vertices must lie
+   * within the guard band.
+   * ****************************************************************************************************
+   * @param p0
+   * : Vertex 1 of the triangle.
+   * @param p1
+   * : Vertex 2 of the triangle.
+   * @param p2
+   * : Vertex 3 of the triangle.
+   * @param setup
+   * : Filled with the triangle's setup data.
+   * @return bool
+   * : False if the triangle was backface-culled or covers no part of the
+   * viewport.
+   * ****************************************************************************************************
+  */
+  static bool setup_triangle(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, TriangleSetup& setup);
+
+  /*!
+   * @brief ___rasterize_triangle___
+   * ****************************************************************************************************
+   * Fills the pixels of a set up triangle that lie in [x0,x1) x [y0,y1).
+   * ****************************************************************************************************
+   * @param setup
+   * : Triangle data from setup_triangle().
+   * @param x0, y0, x1, y1
+   * : Rectangle to rasterize, max is exclusive.
+   * ****************************************************************************************************
+  */
+  static void rasterize_triangle(TriangleSetup const& setup, GLint x0, GLint y0, GLint x1, GLint y1);
+
+  // --- framebuffer layout ---
+
+  // hierarchical rasterization, hierarchical z and the block layout work on
+  // screen aligned blocks of block_size x block_size pixels
+  static constexpr GLint block_size = 8;
+
+  // when set, the emulator draws into a color buffer of its own, and keeps
+  // depth_buffer, in block layout: the pixels of every 8x8 block are 256
+  // contiguous bytes of color (or depth), rows of the block bottom to top,
+  // blocks row by row. A block the rasterizer touches is then 4 cache lines
+  // instead of 8 rows of the pbo. resolve_tiles() detiles the color buffer
+  // into ptr_to_pbo as part of the copy, so the render target always ends up
+  // linear. When cleared, pixels are drawn straight into ptr_to_pbo.
+  static bool block_layout;
+
+  // --- depth buffer ---
+
+  // akin to glEnable(GL_DEPTH_TEST) with glDepthFunc(GL_LESS). Filled
+  // triangles only write pixels nearer than the depth buffer.
+  static bool depth_test;
+
+  // when cleared, back faces are rasterized as well, like glDisable(GL_CULL_FACE)
+  static bool backface_culling;
+
+  // when set, draw_elements() rejects the meshlets of a model that lie
+  // outside the view volume, or whose triangles all face away with
+  // backface_culling, before their vertices are transformed or their
+  // triangles gathered
+  static bool cluster_culling;
+
+  // one depth per pixel in [0, 1], same layout as the pbo or in block
+  // layout, padded to whole blocks
+  static std::vector<GLfloat> depth_buffer;
+
+  // value to use for clearing the depth buffer, akin to glClearDepth
+  static GLfloat clear_depth;
+
+  // akin to glClear(GL_DEPTH_BUFFER_BIT), also resets the hierarchical z
+  // bounds that let occluded blocks be rejected without per pixel tests
+  static void clear_depth_buffer();
+
+  // --- clipping ---
+
+  // triangles only need clipping where they leave the guard band, the
+  // viewport grown by guard_band pixels on every side. Anything inside it is
+  // rasterized as is with its aabb clamped to the viewport, anything entirely
+  // outside the viewport is rejected. Viewports up to
+  // fixed_max_coord - 2 * guard_band pixels keep clipped triangles in fixed
+  // point range.
+  static constexpr GLint guard_band = 1 << 12;
+
+  // Model::clip bits, set for vertices in front of the near plane (z < -w)
+  // or behind the far plane (z > w). Those are the only planes clipped in
+  // clip coordinates, which also keeps w positive for the perspective divide.
+  static constexpr unsigned char clip_near = 1, clip_far = 2;
+
+  // --- fixed point sub-pixel rasterization ---
+
+  // vertices are snapped to 1/(1 << subpixel_bits) pixels (28.4 fixed point)
+  static constexpr GLint subpixel_bits = 4;
+  // triangles with a vertex this many pixels or more away from the origin
+  // are rasterized in float, this keeps every per-block edge value in int32
+  static constexpr GLint fixed_max_coord = 1 << 14;
+
+  // when set, triangles are snapped to 28.4 fixed point and rasterized with
+  // exact 64-bit integer edge equations. Adjacent triangles sharing an edge
+  // never both cover, nor both miss, a pixel center on that edge.
+  static bool fixed_point;
+
+  // --- sort-middle (tile binned) rasterization ---
+
+  // screen tiles are tile_size x tile_size pixels
+  static constexpr GLint tile_size = 64;
+
+  // when set, render_triangle() only bins triangles into screen tiles and
+  // resolve_tiles() rasterizes the tiles on all cores. Output is identical
+  // to the serial path.
+  static bool tiled;
+
+  /*!
+   * @brief ___resolve_tiles___
+   * ****************************************************************************************************
+   * Rasterizes every binned triangle, one tile per worker task, in the order
+   * the triangles were submitted, then empties the bins. With block_layout
+   * it also detiles the color buffer into ptr_to_pbo, and with fast_clear
+   * fills the tiles still flagged as cleared, even if nothing was binned.
+   * Must be called before ptr_to_pbo is unmapped.
+   * ****************************************************************************************************
+  */
+  static void resolve_tiles();
+
+  // --- dirty tiles ---
+
+  // one flag per screen tile, row by row like the bins, set for every tile
+  // a triangle's clamped aabb or a line's pixel touched since it was last
+  // cleared. render_scene() clears it at the start of every frame.
+  static std::vector<unsigned char> drawn_tiles;
+
+  // when set, render_scene() only clears the tiles of the render target that
+  // earlier frames drew into, and the target only presents the tiles drawn
+  // this frame or the frame before, see RenderTarget. Frames in block_layout
+  // without fast_clear still clear and detile everything, but present only
+  // those tiles.
+  static bool dirty_tiles;
+
+  // --- fast clear ---
+
+  // when set, clear_color_buffer() only flags every screen tile as cleared
+  // to clear_clr. A flagged tile is filled the first time a line or a
+  // triangle touches it, while it is about to be drawn anyway, and tiles
+  // nothing touched are filled by resolve_tiles(), which must then run
+  // before ptr_to_pbo is unmapped. With dirty_tiles, tiles the render
+  // target still holds cleared are never written at all. Fills that do
+  // reach memory, and every clear without fast_clear, use non-temporal
+  // stores, so they do not evict the rasterizer's working set from cache.
+  static bool fast_clear;
 };
 
 #endif /* GLPBO_H */
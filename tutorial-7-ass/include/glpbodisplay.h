@@ -0,0 +1,38 @@
+/* !
+@file    glpbodisplay.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace GLPboDisplay, the OpenGL
+objects GLPbo::draw_fullwindow_quad() displays the emulator's images with.
+They used to be static members of GLPbo; they live here so glpbo.h does not
+need GLEW or GLSLShader. Only glpbo.cpp includes this file.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLPBODISPLAY_H
+#define GLPBODISPLAY_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <GL/glew.h> // for access to OpenGL API declarations
+#include <glslshader.h> // GLSLShader class definition
+
+namespace GLPboDisplay
+{
+	extern GLuint		vaoid;		// with GL 4.5, VBO & EBO are not required
+	extern GLuint		elem_cnt;	// how many indices in element buffer
+	extern GLuint		pboid;		// id for PBO, the first of the ring
+	extern GLuint		texid;		// id for texture object
+	extern GLSLShader	shdr_pgm;	// object that abstracts away nitty-gritty
+									// details of shader management
+
+	// part 3.10 and 3.11 of GLPbo::init(), the full-window quad and the
+	// shader program that samples texid onto it
+	void setup_quad_vao();
+	void setup_shdrpgm();
+}
+
+#endif /* GLPBODISPLAY_H */
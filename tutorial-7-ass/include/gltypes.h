@@ -0,0 +1,24 @@
+/* !
+@file    gltypes.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file declares the OpenGL scalar types the graphics pipe emulator uses,
+so glpbo.h and the headers built on it compile without GLEW or any other
+OpenGL header. The typedefs are the same as GLEW's, which may still be
+included before or after this file.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef GLTYPES_H
+#define GLTYPES_H
+
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned char GLubyte;
+typedef float GLfloat;
+
+#endif /* GLTYPES_H */
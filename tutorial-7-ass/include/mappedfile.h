@@ -0,0 +1,84 @@
+/* !
+@file    mappedfile.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of class MappedFile, a read-only view of
+a whole file mapped into the address space, so binary assets can be used
+where they lie instead of being read into buffers of their own.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*  _________________________________________________________________________ */
+class MappedFile
+/*! MappedFile class.
+The mapping is shared and read-only, pages are only read from disk when
+they are first touched and stay in the OS file cache between runs. The file
+must not be written while it is mapped.
+*/
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	/*!
+	 * @brief ___MappedFile::Open___
+	 * ****************************************************************************************************
+	 * Maps a whole file, unmapping whatever was mapped before.
+	 * ****************************************************************************************************
+	 * @param path
+	 * : Path of the file.
+	 * @return bool
+	 * : False if the file could not be opened or mapped. An empty file opens
+	 * with no data.
+	 * ****************************************************************************************************
+	*/
+	bool Open(std::string const& path);
+
+	// unmaps the file, GetData() is null afterwards
+	void Close();
+
+	unsigned char const* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+	/*!
+	 * @brief ___MappedFile::Stat___
+	 * ****************************************************************************************************
+	 * Size and last modification time of a file, without opening it.
+	 * ****************************************************************************************************
+	 * @param path
+	 * : Path of the file.
+	 * @param bytes, mtime
+	 * : Set to the size and the modification time, seconds since 1970.
+	 * @return bool
+	 * : False if there is no such file.
+	 * ****************************************************************************************************
+	*/
+	static bool Stat(std::string const& path, uint64_t& bytes, int64_t& mtime);
+
+private:
+	unsigned char const*	data = nullptr;
+	size_t					size = 0;
+#ifdef _WIN32
+	void*					file = nullptr;		/*!< HANDLE of the file */
+	void*					mapping = nullptr;	/*!< HANDLE of the file mapping */
+#else
+	int						fd = -1;
+#endif
+};
+
+#endif /* MAPPEDFILE_H */
@@ -0,0 +1,133 @@
+/* !
+@file    meshcache.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace MeshCache, a binary cache
+of the models Scene::LoadScene() builds from OBJ files. The first load of
+a mesh parses and post-processes it as usual, then writes the finished
+GLPbo::Model next to the source as <source>.cache. Later loads map the
+cache and copy its arrays straight into the model, no text is parsed.
+
+A cache file, little-endian, is a MeshCache::Header followed by the
+arrays of MeshCache::Array, each starting on a MeshCache::alignment byte
+boundary:
+- positions, normals and texture coordinates in structure of arrays form,
+  one float array per component, padded to a multiple of
+  MeshCache::padding vertices,
+- the triangle indices, 2 bytes each when every vertex fits 16 bits,
+  4 bytes otherwise.
+
+A cache is only used while its version matches MeshCache::version, its
+arrays lie within the file and its indices within its vertices, it was
+built with the build flags the caller asks for, and while its source has
+the size and modification time it was built from, or failing that the
+same FNV-1a hash. A stale or invalid cache is rebuilt, a
+cache whose source is gone is still used.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include <cstdint>
+#include <string>
+
+/*!
+ * @brief ___MeshCache___
+ * *********************
+ * Namespace that reads and writes the binary mesh cache.
+*/
+namespace MeshCache
+{
+	// bump whenever the layout, or how Scene::LoadScene() post-processes
+	// models, changes, every existing cache is then rebuilt
+	constexpr uint32_t	version = 3;
+	constexpr size_t	alignment = 64;		/*!< of every array, one cache line */
+	constexpr uint32_t	padding = 16;		/*!< vertex arrays hold a multiple of this many floats */
+
+	// arrays of a cache file, in file order
+	enum Array : uint32_t
+	{
+		PositionX, PositionY, PositionZ,
+		NormalX, NormalY, NormalZ,
+		TexcoordU, TexcoordV,
+		Indices,
+		ArrayCount
+	};
+
+	/*!
+	 * @brief ___MeshCache::Header___
+	 * *******************************
+	 * First bytes of a cache file.
+	*/
+	struct Header
+	{
+		char		magic[8];				/*!< "GLPBOMSH" */
+		uint32_t	version;				/*!< MeshCache::version of the writer */
+		uint32_t	header_size;			/*!< sizeof(Header) */
+		uint64_t	source_size;			/*!< bytes of the source mesh */
+		int64_t		source_mtime;			/*!< modification time of the source, seconds since 1970 */
+		uint64_t	source_hash;			/*!< FNV-1a hash of the source's bytes */
+		uint32_t	vertex_cnt;
+		uint32_t	padded_cnt;				/*!< vertex_cnt rounded up to a multiple of padding */
+		uint32_t	index_cnt;
+		uint32_t	index_size;				/*!< bytes per index */
+		uint32_t	build_flags;			/*!< how the caller built the model, see Load() */
+		float		bounds_min[3];			/*!< axis-aligned bounds of the positions */
+		float		bounds_max[3];
+		uint64_t	offset[ArrayCount];		/*!< of every array from the start of the file */
+	};
+
+	// path of the cache of a source mesh
+	std::string CachePath(std::string const& source);
+
+	/*!
+	 * @brief ___MeshCache::Load___
+	 * ****************************************************************************************************
+	 * Loads a model from the cache of a source mesh. If there is no usable
+	 * cache, builds the model from the source and writes its cache.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the source mesh.
+	 * @param model
+	 * : Empty model to load into.
+	 * @param build
+	 * : Builds a model from the source, returns false if it could not.
+	 * @param build_flags
+	 * : What build() does differently from one run to the next, such as
+	 * which options it post-processes with. A cache written with other
+	 * flags is rebuilt.
+	 * @return bool
+	 * : False if there was no usable cache and build() failed. A cache that
+	 * could not be written is reported, but the built model is kept.
+	 * ****************************************************************************************************
+	*/
+	bool Load(std::string const& source, GLPbo::Model& model, bool (*build)(std::string const&, GLPbo::Model&),
+		uint32_t build_flags);
+
+	/*!
+	 * @brief ___MeshCache::Write___
+	 * ****************************************************************************************************
+	 * Writes a model to the cache of a source mesh.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the source mesh the model was built from.
+	 * @param model
+	 * : Model to write, its pm, nml, tex and tri or tri32.
+	 * @param build_flags
+	 * : Flags the model was built with, see Load().
+	 * @return bool
+	 * : False, after printing why, if the source could not be read or the
+	 * cache could not be written.
+	 * ****************************************************************************************************
+	*/
+	bool Write(std::string const& source, GLPbo::Model const& model, uint32_t build_flags);
+}
+
+#endif /* MESHCACHE_H */
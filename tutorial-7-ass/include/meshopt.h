@@ -0,0 +1,119 @@
+/* !
+@file    meshopt.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace MeshOpt, which reorders the
+triangles and vertices of a model for the post-transform vertex cache of a
+GPU and for the vertex fetch of the graphics pipe emulator. OBJ files keep
+their triangles in whatever order they were modelled in, so neighbouring
+triangles rarely share recently transformed vertices, and draw_elements()
+gathers window coordinates from all over the vertex arrays.
+
+MeshOpt::Optimize() first orders the triangles with Tipsify (Sander, Nehab
+and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced
+Overdraw", 2007): it fans around one vertex at a time, then moves on to a
+vertex of the fan that is still in a simulated cache of
+MeshOpt::cache_size entries. The vertices are then renumbered in the order
+the triangles first use them, so consecutive triangles read neighbouring
+vertices.
+
+How well an order uses the cache is measured as the average cache miss
+ratio, the vertices a FIFO cache of MeshOpt::cache_size entries misses per
+triangle: 3 when no vertex is reused, about 0.5 at best for a regular grid.
+
+MeshOpt::BuildMeshlets() then cuts the triangles, in that order, into
+meshlets of MeshOpt::meshlet_min to MeshOpt::meshlet_max triangles, each
+with a bounding sphere and a cone around its normals, so draw_elements()
+can reject meshlets outside the view volume or facing away as a whole.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef MESHOPT_H
+#define MESHOPT_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+
+/*!
+ * @brief ___MeshOpt___
+ * *********************
+ * Namespace that reorders models for vertex cache and fetch locality
+ * and splits them into meshlets.
+*/
+namespace MeshOpt
+{
+	// entries of the FIFO vertex cache that is optimized for and measured,
+	// as many as the post-transform caches of most GPUs hold
+	constexpr size_t	cache_size = 16;
+
+	// triangles per meshlet, one ends early past meshlet_min once a
+	// triangle turns more than meshlet_turn radians from the mean normal
+	constexpr size_t	meshlet_min = 64;
+	constexpr size_t	meshlet_max = 128;
+	constexpr float		meshlet_turn = 0.785f;
+
+	// radians a normal cone is widened by against rounding
+	constexpr float		cone_slack = 0.01f;
+
+	/*!
+	 * @brief ___MeshOpt::Stats___
+	 * *******************************
+	 * Average cache miss ratio of a model before and after Optimize().
+	*/
+	struct Stats
+	{
+		float	acmr_before{ 0.f };
+		float	acmr_after{ 0.f };
+	};
+
+	/*!
+	 * @brief ___MeshOpt::ACMR___
+	 * ****************************************************************************************************
+	 * Average cache miss ratio of a model's triangles in their current
+	 * order, through a FIFO cache of cache_size vertices.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to measure, its tri or tri32.
+	 * @return float
+	 * : Cache misses per triangle, 0 for a model without triangles.
+	 * ****************************************************************************************************
+	*/
+	float ACMR(GLPbo::Model const& model);
+
+	/*!
+	 * @brief ___MeshOpt::Optimize___
+	 * ****************************************************************************************************
+	 * Reorders a model's triangles with Tipsify, then its vertices in the
+	 * order the triangles first use them. Vertices no triangle uses are
+	 * kept, after the others. The winding of every triangle is kept, so is
+	 * what it looks like, except where triangles that overlap on screen are
+	 * drawn without a depth test.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to reorder, its pm, nml, tex and tri or tri32. The vertex
+	 * stage buffers are cleared, transform_vertices() fills them again.
+	 * @return Stats
+	 * : ACMR of the model before and after.
+	 * ****************************************************************************************************
+	*/
+	Stats Optimize(GLPbo::Model& model);
+
+	/*!
+	 * @brief ___MeshOpt::BuildMeshlets___
+	 * ****************************************************************************************************
+	 * Splits a model's triangles, in their current order, into meshlets of
+	 * meshlet_min to meshlet_max triangles and bounds each. Best done after
+	 * Optimize(), which keeps the triangles and vertices of a meshlet close.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to split, its meshlets are replaced.
+	 * ****************************************************************************************************
+	*/
+	void BuildMeshlets(GLPbo::Model& model);
+}
+
+#endif /* MESHOPT_H */
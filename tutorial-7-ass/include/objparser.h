@@ -0,0 +1,89 @@
+/* !
+@file    objparser.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace ObjParser, a parallel
+parser of OBJ files with the parameters of DPML::parse_obj_mesh(), but for
+32-bit triangle indices. Its output follows the rules documented with
+Parse(); whether DPML's does too is what tutorial-7-headless -compare
+checks, in builds with DPML.
+The file is mapped and split into chunks of whole lines, which are parsed
+on the threads of a ThreadPool: a first pass counts the v, vt and vn
+records of every chunk, so the second pass can resolve relative indices
+and write attributes straight to their final place. A serial merge then
+makes one vertex per distinct position, texture coordinate and normal and
+fixes up the triangle indices.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef OBJPARSER_H
+#define OBJPARSER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+class ThreadPool; // threadpool.h
+
+/*!
+ * @brief ___ObjParser___
+ * *********************
+ * Namespace that parses OBJ files on many threads.
+*/
+namespace ObjParser
+{
+	/*!
+	 * @brief ___ObjParser::Parse___
+	 * ****************************************************************************************************
+	 * Parses an OBJ file. The parameters follow the documentation of
+	 * DPML::parse_obj_mesh() in dpml.h, the output these rules:
+	 * - v, vt, vn and f records are read, every other record is skipped,
+	 *   faces with more than 3 corners are split into a fan of triangles and
+	 *   negative indices count back from the last record read,
+	 * - vertex i is position i of the file, with the texture coordinate and
+	 *   normal of the first corner that uses it; corners that use a
+	 *   position with another texture coordinate or normal get a vertex of
+	 *   their own, appended after the positions,
+	 * - normals missing from the file are the normalized, area weighted
+	 *   sum of the normals of the triangles around their position,
+	 * - texcoords is left empty when the file has none,
+	 * - triangles are 32-bit, so models of any size can be parsed, see
+	 *   GLPbo::Model::set_triangles() to narrow them.
+	 * ****************************************************************************************************
+	 * @param filename
+	 * : Path of the .obj file.
+	 * @param positions, normals, texcoords, triangles
+	 * : Empty containers to parse into.
+	 * @param load_nml_coord_flag
+	 * : Fill normals, from the file or computed.
+	 * @param load_tex_coord_flag
+	 * : Fill texcoords, if the file has texture coordinates.
+	 * @param model_centered_flag
+	 * : Translate the positions so the center of their bounding box is at
+	 * the origin.
+	 * @param pool
+	 * : Threads to parse the chunks on, along with the caller, which parses
+	 * them alone if null. Parsing does not spawn threads of its own.
+	 * @return bool
+	 * : False, after printing why, if the file could not be mapped, has no
+	 * positions or an index out of range.
+	 * ****************************************************************************************************
+	*/
+	bool Parse(std::string const& filename,
+		std::vector<glm::vec3>& positions,
+		std::vector<glm::vec3>& normals,
+		std::vector<glm::vec2>& texcoords,
+		std::vector<uint32_t>& triangles,
+		bool load_nml_coord_flag,
+		bool load_tex_coord_flag,
+		bool model_centered_flag = true,
+		ThreadPool* pool = nullptr);
+}
+
+#endif /* OBJPARSER_H */
@@ -0,0 +1,73 @@
+/* !
+@file    pborendertarget.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of class PboRenderTarget, the render
+target of the windowed application, a ring of persistently mapped PBOs each
+copied to a texture on Unmap(). It is split from rendertarget.h because it
+needs OpenGL, the rest of the emulator builds without it.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef PBORENDERTARGET_H
+#define PBORENDERTARGET_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+// builds without GLEW, like the EGL check, take the prototypes from the
+// system's glcorearb.h and link the GL library directly
+#ifdef GLPBO_NO_GLEW
+#define GL_GLEXT_PROTOTYPES 1
+#include <GL/glcorearb.h>
+#else
+#include <GL/glew.h> // for access to OpenGL API declarations
+#endif
+#include "rendertarget.h"
+
+/*  _________________________________________________________________________ */
+class PboRenderTarget : public RenderTarget
+/*! PboRenderTarget class.
+Color buffer in a ring of ring_size PBOs that stay mapped, persistent and
+coherent, for their whole lifetime. Map() hands out the next PBO of the
+ring and Unmap() DMAs its changed tiles into a texture of the same size
+that can be drawn on a quad, then fences the copy. The CPU only waits, in
+Map(), when it comes back around to a PBO whose copy is still in flight,
+so frame N + 1 is rasterized while frame N uploads. Requires a current
+OpenGL 4.4+ context.
+*/
+{
+public:
+	static constexpr int ring_size = 3;
+
+	PboRenderTarget(GLsizei w, GLsizei h);
+	~PboRenderTarget() override;
+
+	GLPbo::Color* Map() override;
+	void Unmap() override;
+
+	// PBO handed out by the last Map()
+	GLuint GetPbo() const { return pboids[buffer]; }
+	GLuint GetTexture() const { return texid; }
+
+	// frames mapped, how many of them waited on a fence, and for how long
+	unsigned long long GetFrameCount() const { return frame_cnt; }
+	unsigned long long GetWaitCount() const { return wait_cnt; }
+	double GetWaitSeconds() const { return wait_seconds; }
+
+	// bytes copied to the texture so far
+	unsigned long long GetUploadBytes() const { return upload_bytes; }
+
+private:
+	GLuint				pboids[ring_size];
+	GLPbo::Color*		mapped[ring_size];		/*!< persistent client addresses of pboids */
+	GLsync				fences[ring_size];		/*!< signaled once the copy out of each PBO is done, 0 if none is pending */
+	GLuint				texid;
+
+	unsigned long long	frame_cnt, wait_cnt, upload_bytes;
+	double				wait_seconds;
+};
+
+#endif /* PBORENDERTARGET_H */
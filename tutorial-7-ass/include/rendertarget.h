@@ -0,0 +1,142 @@
+/* !
+@file    rendertarget.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of class RenderTarget, the color buffer
+the graphics pipe emulator draws into, and of HostRenderTarget, plain
+aligned host memory that needs no OpenGL context, used by the headless
+renderer. The windowed application's PboRenderTarget is in
+pborendertarget.h, the only render target that needs OpenGL.
+Also declares helpers that dump a color buffer to PPM and PNG files.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef RENDERTARGET_H
+#define RENDERTARGET_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include <string>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+class RenderTarget
+/*! RenderTarget class.
+A width x height buffer of GLPbo::Color, row 0 at the bottom like a GL
+texture, or a ring of buffer_cnt of them that Map() hands out in turn. The
+pixels may only be written between Map() and Unmap().
+
+The target also tracks dirty tiles, one flag per GLPbo::tile_size square
+in the order of GLPbo::drawn_tiles, so a frame only has to clear and
+present the tiles that changed:
+- stale tiles of a buffer hold pixels an earlier frame drew into it,
+  anything else still has the clear color,
+- changed tiles were drawn into this frame or the frame before, anything
+  else is the same as in the image presented last.
+Frames that do not report the tiles they drew leave every tile of their
+buffer stale and changed.
+*/
+{
+public:
+	RenderTarget(GLsizei w, GLsizei h, int buffers = 1);
+	virtual ~RenderTarget() = default;
+
+	RenderTarget(RenderTarget const&) = delete;
+	RenderTarget& operator=(RenderTarget const&) = delete;
+
+	// begins a frame, returns the writable color buffer
+	virtual GLPbo::Color* Map() = 0;
+
+	// ends a frame, the pointer returned by Map() must not be used anymore
+	virtual void Unmap() = 0;
+
+	GLsizei GetWidth() const { return width; }
+	GLsizei GetHeight() const { return height; }
+
+	// stale tiles of the buffer returned by the last Map()
+	std::vector<unsigned char> const& GetStale() const { return stale[buffer]; }
+
+	// reports the tiles drawn into since Map(), before Unmap()
+	void SetDrawn(std::vector<unsigned char> const& tiles);
+
+	// makes every tile of every buffer stale and changed
+	void Invalidate();
+
+	// Invalidate()s the target if its tiles were cleared to another color
+	void SetClearColor(GLPbo::Color clr);
+
+protected:
+	// to be called by Unmap() once it presented the changed tiles
+	void EndFrame();
+
+	GLsizei										width, height;
+	int											buffer;			/*!< index of the buffer returned by the last Map() */
+	std::vector<std::vector<unsigned char>>		stale;			/*!< per buffer */
+	std::vector<unsigned char>					changed;		/*!< tiles Unmap() has to present */
+	std::vector<unsigned char>					last_drawn;		/*!< tiles drawn the frame before */
+	GLint										tile_cols;		/*!< tiles per row */
+	GLPbo::Color								cleared_to;		/*!< color the tiles that are not stale have */
+	bool										reported;		/*!< SetDrawn() was called this frame */
+};
+
+/*  _________________________________________________________________________ */
+class HostRenderTarget : public RenderTarget
+/*! HostRenderTarget class.
+Color buffer in host memory. The buffer starts on a cache line so SIMD rows
+and the tiles of different threads line up with cache lines. Map() and
+Unmap() cost nothing, the pixels stay readable after Unmap().
+*/
+{
+public:
+	static constexpr size_t alignment = 64;
+
+	HostRenderTarget(GLsizei w, GLsizei h);
+
+	GLPbo::Color* Map() override { return pixels; }
+	void Unmap() override { EndFrame(); }
+
+	GLPbo::Color const* GetPixels() const { return pixels; }
+
+private:
+	std::vector<unsigned char>	storage;	/*!< over-allocated by alignment bytes */
+	GLPbo::Color*				pixels;		/*!< first aligned pixel in storage */
+};
+
+/*!
+ * @brief ___WritePPM___
+ * ****************************************************************************************************
+ * Writes a color buffer to a binary (P6) PPM file, top row first, alpha is
+ * dropped.
+ * ****************************************************************************************************
+ * @param path
+ * : File to write.
+ * @param pixels, width, height
+ * : Color buffer with row 0 at the bottom.
+ * @return bool
+ * : False if the file could not be written.
+ * ****************************************************************************************************
+*/
+bool WritePPM(std::string const& path, GLPbo::Color const* pixels, GLsizei width, GLsizei height);
+
+/*!
+ * @brief ___WritePNG___
+ * ****************************************************************************************************
+ * Writes a color buffer to an 8-bit RGB PNG file, top row first, alpha is
+ * dropped. The image data is stored uncompressed, this only needs to be
+ * readable by image viewers and diff tools, not small.
+ * ****************************************************************************************************
+ * @param path
+ * : File to write.
+ * @param pixels, width, height
+ * : Color buffer with row 0 at the bottom.
+ * @return bool
+ * : False if the file could not be written.
+ * ****************************************************************************************************
+*/
+bool WritePNG(std::string const& path, GLPbo::Color const* pixels, GLsizei width, GLsizei height);
+
+#endif /* RENDERTARGET_H */
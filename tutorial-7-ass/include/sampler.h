@@ -0,0 +1,283 @@
+/* !
+@file    sampler.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the texture sampler of the graphics pipe emulator, which
+filters GLPbo::Texture texels for SIMD::width pixels at a time. It works
+like a GPU texture unit:
+- the level of detail comes from the screen space derivatives of the
+  texture coordinates, which the rasterizer takes over 2x2 pixel quads,
+- texel coordinates wrap like GL_REPEAT,
+- each lane may read a different mip level, its size and offset are
+  gathered from the texture's level tables,
+- texel addresses are generated for the texture's layout, every function
+  that touches texels is a template on it so the layout is picked once
+  per sample.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include "simd.h"
+
+namespace Sampler
+{
+	/*!
+	 * @brief ___Sampler::Texel___
+	 * *******************************
+	 * Filtered red, green and blue channels of SIMD::width pixels, in [0, 255].
+	*/
+	struct Texel
+	{
+		SIMD::Float	r, g, b;
+	};
+
+	/*!
+	 * @brief ___Sampler::Level___
+	 * *******************************
+	 * Size and first texel of the mip level each lane reads from.
+	*/
+	struct Level
+	{
+		SIMD::Float	w, h;				/*!< size in texels */
+		SIMD::Int	wmask, hmask;		/*!< size - 1, wraps texel coordinates */
+		SIMD::Int	xmask, ymask;		/*!< Morton: wmask and hmask spread to the even and odd bits */
+		SIMD::Int	offset;				/*!< first texel in Texture::texels */
+
+		Level(GLPbo::Texture const& t, SIMD::Int l, bool morton)
+		{
+			SIMD::Int iw = SIMD::Gather(t.level_width, l), ih = SIMD::Gather(t.level_height, l);
+			w = SIMD::ToFloat(iw);
+			h = SIMD::ToFloat(ih);
+			wmask = iw + SIMD::Set1(-1);
+			hmask = ih + SIMD::Set1(-1);
+			xmask = morton ? SIMD::Gather(t.level_xmask, l) : SIMD::Set1(0);
+			ymask = morton ? SIMD::Gather(t.level_ymask, l) : SIMD::Set1(0);
+			offset = SIMD::Gather(t.level_offset, l);
+		}
+	};
+
+	/*!
+	 * @brief ___Sampler::Spread___
+	 * *******************************
+	 * Moves bit i of 16-bit lanes to bit 2i, the x part of a Morton index.
+	*/
+	inline SIMD::Int Spread(SIMD::Int v)
+	{
+		v = (v | (v << 8)) & SIMD::Set1(0x00FF00FF);
+		v = (v | (v << 4)) & SIMD::Set1(0x0F0F0F0F);
+		v = (v | (v << 2)) & SIMD::Set1(0x33333333);
+		v = (v | (v << 1)) & SIMD::Set1(0x55555555);
+		return v;
+	}
+
+	/*!
+	 * @brief ___Sampler::CoordX___
+	 * ****************************************************************************************************
+	 * Wrapped texel columns in the form the layout adds up into an index:
+	 * the column itself for Linear, spread to the even bits for Morton.
+	 * ****************************************************************************************************
+	*/
+	template <bool Morton>
+	inline SIMD::Int CoordX(Level const& l, SIMD::Int ix)
+	{
+		return Morton ? Spread(ix & l.wmask) : ix & l.wmask;
+	}
+	// CoordX() for rows, which Morton spreads to the odd bits
+	template <bool Morton>
+	inline SIMD::Int CoordY(Level const& l, SIMD::Int iy)
+	{
+		return Morton ? Spread(iy & l.hmask) << 1 : iy & l.hmask;
+	}
+
+	/*!
+	 * @brief ___Sampler::NextX___
+	 * ****************************************************************************************************
+	 * Coordinates one texel to the right of CoordX() ones, wrapped. In Morton
+	 * form the odd bits are filled with ones so the increment carries across
+	 * them, which saves spreading the neighbour's coordinate again.
+	 * ****************************************************************************************************
+	*/
+	template <bool Morton>
+	inline SIMD::Int NextX(Level const& l, SIMD::Int cx)
+	{
+		return Morton ?
+			((cx | SIMD::Set1(static_cast<int32_t>(0xAAAAAAAA))) + SIMD::Set1(1)) & l.xmask :
+			(cx + SIMD::Set1(1)) & l.wmask;
+	}
+	// NextX() for CoordY() rows
+	template <bool Morton>
+	inline SIMD::Int NextY(Level const& l, SIMD::Int cy)
+	{
+		return Morton ?
+			((cy | SIMD::Set1(0x55555555)) + SIMD::Set1(1)) & l.ymask :
+			(cy + SIMD::Set1(1)) & l.hmask;
+	}
+
+	/*!
+	 * @brief ___Sampler::Lod___
+	 * ****************************************************************************************************
+	 * Level of detail of SIMD::width pixels, akin to the GL spec's lambda:
+	 * log2 of the longer of the pixel's footprints along x and y in level 0
+	 * texels, clamped to the texture's levels.
+	 * ****************************************************************************************************
+	 * @param dudx, dvdx, dudy, dvdy
+	 * : Screen space derivatives of the texture coordinates.
+	 * ****************************************************************************************************
+	*/
+	inline SIMD::Float Lod(GLPbo::Texture const& t, SIMD::Float dudx, SIMD::Float dvdx, SIMD::Float dudy, SIMD::Float dvdy)
+	{
+		SIMD::Float w = SIMD::Set1(static_cast<float>(t.level_width[0]));
+		SIMD::Float h = SIMD::Set1(static_cast<float>(t.level_height[0]));
+		SIMD::Float ux = dudx * w, vx = dvdx * h, uy = dudy * w, vy = dvdy * h;
+		SIMD::Float rho2 = SIMD::Max(ux * ux + vx * vx, uy * uy + vy * vy);
+
+		// log2(rho) = log2(rho^2) / 2 saves the square root
+		SIMD::Float lod = SIMD::Set1(0.5f) * SIMD::Log2(rho2);
+		return SIMD::Min(SIMD::Max(lod, SIMD::Set1(0.f)), SIMD::Set1(static_cast<float>(t.levels - 1)));
+	}
+
+	/*!
+	 * @brief ___Sampler::Fetch___
+	 * *******************************
+	 * Texels (cx, cy) of each lane's level, from CoordX() and CoordY().
+	*/
+	template <bool Morton>
+	inline SIMD::Int Fetch(GLPbo::Texture const& t, Level const& l, SIMD::Int cx, SIMD::Int cy)
+	{
+		SIMD::Int index;
+		if (Morton)
+		{
+			index = (cx | cy) + l.offset;
+		}
+		else
+		{
+			// SSE2 has no 32-bit multiply, row * w + column is exact in float
+			// while a level has fewer than 2^24 texels
+			index = SIMD::Truncate(SIMD::ToFloat(cy) * l.w + SIMD::ToFloat(cx)) + l.offset;
+		}
+		return SIMD::Gather(reinterpret_cast<int32_t const*>(t.texels.data()), index);
+	}
+
+	/*!
+	 * @brief ___Sampler::Channel___
+	 * *******************************
+	 * Byte c of packed RGBA texels as float.
+	*/
+	inline SIMD::Float Channel(SIMD::Int texel, int c)
+	{
+		return SIMD::ToFloat((texel >> (8 * c)) & SIMD::Set1(0xFF));
+	}
+
+	/*!
+	 * @brief ___Sampler::Nearest___
+	 * *******************************
+	 * Nearest texel to (u, v) in each lane's level, as an opaque pixel.
+	*/
+	template <bool Morton>
+	inline SIMD::Int Nearest(GLPbo::Texture const& t, Level const& l, SIMD::Float u, SIMD::Float v)
+	{
+		SIMD::Int cx = CoordX<Morton>(l, SIMD::Truncate(SIMD::Floor(u * l.w)));
+		SIMD::Int cy = CoordY<Morton>(l, SIMD::Truncate(SIMD::Floor(v * l.h)));
+		return Fetch<Morton>(t, l, cx, cy) | SIMD::Set1(static_cast<int32_t>(0xFF000000));
+	}
+
+	/*!
+	 * @brief ___Sampler::Bilinear___
+	 * *******************************
+	 * The 2x2 texels around (u, v) in each lane's level, weighted by the
+	 * distance to their centers.
+	*/
+	template <bool Morton>
+	inline Texel Bilinear(GLPbo::Texture const& t, Level const& l, SIMD::Float u, SIMD::Float v)
+	{
+		// texel centers are at half integers
+		SIMD::Float x = u * l.w - SIMD::Set1(0.5f), y = v * l.h - SIMD::Set1(0.5f);
+		SIMD::Float x0 = SIMD::Floor(x), y0 = SIMD::Floor(y);
+		SIMD::Float fx = x - x0, fy = y - y0;
+		SIMD::Int cx0 = CoordX<Morton>(l, SIMD::Truncate(x0)), cy0 = CoordY<Morton>(l, SIMD::Truncate(y0));
+		SIMD::Int cx1 = NextX<Morton>(l, cx0), cy1 = NextY<Morton>(l, cy0);
+
+		SIMD::Int t00 = Fetch<Morton>(t, l, cx0, cy0), t10 = Fetch<Morton>(t, l, cx1, cy0);
+		SIMD::Int t01 = Fetch<Morton>(t, l, cx0, cy1), t11 = Fetch<Morton>(t, l, cx1, cy1);
+		SIMD::Float one = SIMD::Set1(1.f);
+		SIMD::Float w00 = (one - fx) * (one - fy), w10 = fx * (one - fy);
+		SIMD::Float w01 = (one - fx) * fy, w11 = fx * fy;
+		auto filter = [&](int c)
+		{
+			return Channel(t00, c) * w00 + Channel(t10, c) * w10 + Channel(t01, c) * w01 + Channel(t11, c) * w11;
+		};
+		return { filter(0), filter(1), filter(2) };
+	}
+
+	/*!
+	 * @brief ___Sampler::Pack___
+	 * *******************************
+	 * Filtered channels rounded to an opaque pixel.
+	*/
+	inline SIMD::Int Pack(Texel const& texel)
+	{
+		SIMD::Float half = SIMD::Set1(0.5f);
+		return SIMD::PackColor(texel.r + half, texel.g + half, texel.b + half);
+	}
+
+	/*!
+	 * @brief ___Sampler::SampleLayout___
+	 * *******************************
+	 * Sample() for a texture whose layout is known at compile time.
+	*/
+	template <bool Morton>
+	inline SIMD::Int SampleLayout(GLPbo::Texture const& t, GLPbo::Texture::Filter filter, SIMD::Float lod, SIMD::Float u, SIMD::Float v)
+	{
+		if (filter != GLPbo::Texture::Filter::Trilinear)
+		{
+			Level level(t, SIMD::Truncate(lod + SIMD::Set1(0.5f)), Morton);
+			return filter == GLPbo::Texture::Filter::Nearest ? Nearest<Morton>(t, level, u, v) : Pack(Bilinear<Morton>(t, level, u, v));
+		}
+
+		// lod is not negative, truncation floors it
+		SIMD::Int l0 = SIMD::Truncate(lod);
+		SIMD::Float f = lod - SIMD::ToFloat(l0);
+		SIMD::Int l1 = SIMD::Truncate(SIMD::Min(lod + SIMD::Set1(1.f), SIMD::Set1(static_cast<float>(t.levels - 1))));
+		Texel a = Bilinear<Morton>(t, Level(t, l0, Morton), u, v);
+		Texel b = Bilinear<Morton>(t, Level(t, l1, Morton), u, v);
+		return Pack({ a.r + (b.r - a.r) * f, a.g + (b.g - a.g) * f, a.b + (b.b - a.b) * f });
+	}
+
+	/*!
+	 * @brief ___Sampler::Sample___
+	 * ****************************************************************************************************
+	 * Samples a texture at (u, v) for SIMD::width pixels, akin to GLSL's
+	 * texture(): picks the level of detail from the derivatives, then filters
+	 * the texels of the nearest level, or of the two nearest levels for
+	 * Filter::Trilinear.
+	 * ****************************************************************************************************
+	 * @param filter
+	 * : Same for every pixel of a draw, so the branches on it and on the
+	 * texture's layout are uniform.
+	 * @param u, v
+	 * : Texture coordinates, wrapped like GL_REPEAT.
+	 * @param dudx, dvdx, dudy, dvdy
+	 * : Screen space derivatives of u and v.
+	 * @return SIMD::Int
+	 * : Opaque RGBA pixels.
+	 * ****************************************************************************************************
+	*/
+	inline SIMD::Int Sample(GLPbo::Texture const& t, GLPbo::Texture::Filter filter, SIMD::Float u, SIMD::Float v,
+		SIMD::Float dudx, SIMD::Float dvdx, SIMD::Float dudy, SIMD::Float dvdy)
+	{
+		SIMD::Float lod = Lod(t, dudx, dvdx, dudy, dvdy);
+		return t.layout == GLPbo::Texture::Layout::Morton ?
+			SampleLayout<true>(t, filter, lod, u, v) :
+			SampleLayout<false>(t, filter, lod, u, v);
+	}
+}
+
+#endif /* SAMPLER_H */
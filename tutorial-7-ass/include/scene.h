@@ -0,0 +1,137 @@
+/* !
+@file    scene.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the declaration of namespace Scene, the models loaded
+from a .scn file and how the current one is drawn by the graphics pipe
+emulator. Everything but Scene::ProcessInput() is independent of OpenGL
+and GLFW so the same scene can be drawn by the windowed application and
+the headless renderer.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef SCENE_H
+#define SCENE_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include <string>
+#include <vector>
+
+/*!
+ * @brief ___Scene___
+ * *********************
+ * Namespace that holds scene variables.
+*/
+namespace Scene
+{
+	using DrawMode = GLPbo::DrawMode;
+
+	extern unsigned int					current_model;
+	extern std::vector<GLPbo::Model>	models;
+	extern DrawMode						current_draw_mode;
+	extern bool							rotate;
+	extern double						orientation;
+	// camera of the scene, the identity keeps the model's [-1, 1] box as
+	// the view volume
+	extern glm::mat4					view_projection;
+	// texture of Textured mode and how it is filtered
+	extern GLPbo::Texture				texture;
+	extern GLPbo::Texture::Filter		texture_filter;
+	// when set, LoadScene() loads models from their binary cache
+	extern bool							mesh_cache;
+	// when set, models are parsed by ObjParser on the rasterizer's
+	// workers, see GLPbo::init_rasterizer(), instead of
+	// DPML::parse_obj_mesh(), which only builds with DPML, see scene.cpp
+	extern bool							parallel_obj;
+	// when set, models built from OBJ files are reordered for the vertex
+	// cache, models cached with the other setting are rebuilt
+	extern bool							optimize_meshes;
+
+	/*!
+	 * @brief ___Scene::LoadScene___
+	 * *******************************
+	 * Loads a scene from a .scn file, every model from the binary cache
+	 * of its OBJ file if it is up to date and was built with the current
+	 * parallel_obj and optimize_meshes, see meshcache.h.
+	 * **************
+	 * @param scene
+	 * : Path of the .scn file.
+	 * @return bool
+	 * : False if the .scn file could not be read.
+	*/
+	bool LoadScene(const std::string& scene);
+
+	/*!
+	 * @brief ___Scene::CompareParsers___
+	 * *******************************
+	 * Parses every model of a .scn file with both ObjParser and
+	 * DPML::parse_obj_mesh() and prints how their outputs differ. Only
+	 * builds with DPML can compare, see scene.cpp.
+	 * **************
+	 * @param scene
+	 * : Path of the .scn file.
+	 * @return bool
+	 * : False if any model did not match or could not be parsed, or if
+	 * this build has no DPML to compare with.
+	*/
+	bool CompareParsers(const std::string& scene);
+
+	/*!
+	 * @brief ___Scene::LoadTexture___
+	 * *******************************
+	 * Loads the texture of Textured mode from a 256 x 256 .tex file and
+	 * builds its mip chain.
+	 * **************
+	 * @param path
+	 * : Path of the .tex file.
+	 * @return bool
+	 * : False if the .tex file could not be read.
+	*/
+	bool LoadTexture(const std::string& path);
+
+	// displays the next model and resets relevant variables
+	void NextModel();
+
+	// changes the draw mode of the displayed model
+	void NextDrawMode();
+
+	// changes how the texture of Textured mode is filtered
+	void NextTextureFilter();
+
+	// toggles if the current model should rotate or not
+	void ToggleRotate();
+
+	/*!
+	 * @brief ___Scene::Update___
+	 * *******************************
+	 * Advances the rotation of the current model, if toggled.
+	 * **************
+	 * @param delta_time
+	 * : Seconds since the previous frame.
+	*/
+	void Update(double delta_time);
+
+	/*!
+	 * @brief ___Scene::ProcessInput___
+	 * ***********************************
+	 * Processes scene inputs, to switch model, draw mode, rotate, etc.
+	 * Reads GLHelper's key states, so it is defined with the rest of the
+	 * OpenGL code in glpbo.cpp.
+	*/
+	void ProcessInput();
+
+	/*!
+	 * @brief ___Scene::DrawScene___
+	 * *******************************
+	 * Renders the current selected model with the draw mode selected into
+	 * GLPbo::ptr_to_pbo.
+	*/
+	void DrawScene();
+}
+
+#endif /* SCENE_H */
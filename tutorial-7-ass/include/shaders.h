@@ -0,0 +1,155 @@
+/* !
+@file    shaders.h
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the shaders the graphics pipe emulator draws filled
+triangles with. A shader is a plain, trivially copyable struct of uniforms
+with:
+- static constexpr int varyings: how many floats its vertex function passes
+  on to its fragment function, at most GLPbo::max_varyings,
+- static constexpr bool quads: if set, the fragment function also gets the
+  screen space derivatives of the varyings, taken over 2x2 pixel quads,
+- void vertex(GLPbo::Model const& model, GLuint i, GLfloat* out) const:
+  writes the varyings of vertex i of a model,
+- GLPbo::Color face(size_t f) const: flat color of triangle f of a model,
+- SIMD::Int fragment(GLPbo::TriangleSetup const& s, SIMD::Float const* v) const:
+  colors of SIMD::width pixels of a triangle given their perspective-correct
+  varyings v[0, varyings), followed for quads shaders by their derivatives
+  along x, v[varyings, 2 * varyings), and along y, v[2 * varyings,
+  3 * varyings). A shader without varyings is flat, its fragment function
+  must return s.clr, which covered blocks are filled with directly.
+GLPbo::draw_elements() and GLPbo::render_triangle() are templates on the
+shader, so every shader gets its own rasterization kernels with its
+functions inlined into the core loop: there is no call or branch on the
+draw mode per pixel. The kernels live in rasterizer.cpp, which instantiates
+them for every shader declared here.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef SHADERS_H
+#define SHADERS_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include "sampler.h"
+#include "simd.h"
+
+namespace Shaders
+{
+	/*!
+	 * @brief ___Shaders::Flat___
+	 * *******************************
+	 * One color per triangle, from face_clr.
+	*/
+	struct Flat
+	{
+		static constexpr int varyings = 0;
+		static constexpr bool quads = false;
+
+		glm::vec3 const*	face_clr = nullptr;		/*!< one color per triangle, channels in [0, 255] */
+
+		void vertex(GLPbo::Model const&, GLuint, GLfloat*) const {}
+
+		GLPbo::Color face(size_t f) const
+		{
+			glm::vec3 const& c = face_clr[f];
+			return { (GLubyte)c.x, (GLubyte)c.y, (GLubyte)c.z, 255 };
+		}
+
+		SIMD::Int fragment(GLPbo::TriangleSetup const& s, SIMD::Float const*) const
+		{
+			return SIMD::Set1(static_cast<int32_t>(s.clr.raw));
+		}
+	};
+
+	/*!
+	 * @brief ___Shaders::Gouraud___
+	 * *******************************
+	 * Vertex colors interpolated across the triangle. Varyings 0, 1 and 2
+	 * are the red, green and blue channels in [0, 255], taken from the
+	 * model's normals mapped to [0, 1].
+	*/
+	struct Gouraud
+	{
+		static constexpr int varyings = 3;
+		static constexpr bool quads = false;
+
+		void vertex(GLPbo::Model const& model, GLuint i, GLfloat* out) const
+		{
+			glm::vec3 clr = model.nml[i] * 255.0f;
+			out[0] = clr.x, out[1] = clr.y, out[2] = clr.z;
+		}
+
+		GLPbo::Color face(size_t) const { return {}; }
+
+		SIMD::Int fragment(GLPbo::TriangleSetup const&, SIMD::Float const* v) const
+		{
+			return SIMD::PackColor(v[0], v[1], v[2]);
+		}
+	};
+
+	/*!
+	 * @brief ___Shaders::Normal___
+	 * *******************************
+	 * Normal visualization. The vertex normals are interpolated and
+	 * renormalized per pixel, then mapped to colors like the normals of a
+	 * normal map, so curved surfaces shade smoothly even where their
+	 * triangles are large.
+	*/
+	struct Normal
+	{
+		static constexpr int varyings = 3;
+		static constexpr bool quads = false;
+
+		void vertex(GLPbo::Model const& model, GLuint i, GLfloat* out) const
+		{
+			// Scene::LoadScene() mapped the normals to [0, 1]
+			glm::vec3 n = model.nml[i] * 2.0f - 1.0f;
+			out[0] = n.x, out[1] = n.y, out[2] = n.z;
+		}
+
+		GLPbo::Color face(size_t) const { return {}; }
+
+		SIMD::Int fragment(GLPbo::TriangleSetup const&, SIMD::Float const* v) const
+		{
+			SIMD::Float len = SIMD::Sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			SIMD::Float scale = SIMD::Set1(127.5f) / SIMD::Max(len, SIMD::Set1(1e-6f));
+			SIMD::Float bias = SIMD::Set1(127.5f);
+			return SIMD::PackColor(v[0] * scale + bias, v[1] * scale + bias, v[2] * scale + bias);
+		}
+	};
+
+	/*!
+	 * @brief ___Shaders::Textured___
+	 * *******************************
+	 * The model's texture coordinates, interpolated perspective-correctly,
+	 * sample a texture. The derivatives of the coordinates over each 2x2
+	 * quad pick the mip level, see sampler.h.
+	*/
+	struct Textured
+	{
+		static constexpr int varyings = 2;
+		static constexpr bool quads = true;
+
+		GLPbo::Texture const*	texture = nullptr;								/*!< texture with its mip chain built */
+		GLPbo::Texture::Filter	filter = GLPbo::Texture::Filter::Trilinear;		/*!< how texels are filtered */
+
+		void vertex(GLPbo::Model const& model, GLuint i, GLfloat* out) const
+		{
+			out[0] = model.tex[i].x, out[1] = model.tex[i].y;
+		}
+
+		GLPbo::Color face(size_t) const { return {}; }
+
+		SIMD::Int fragment(GLPbo::TriangleSetup const&, SIMD::Float const* v) const
+		{
+			return Sampler::Sample(*texture, filter, v[0], v[1], v[2], v[3], v[4], v[5]);
+		}
+	};
+}
+
+#endif /* SHADERS_H */
@@ -0,0 +1,293 @@
+/* !
+@file    simd.h
+@author  z.tay@digipen.edu
+@date    17/10/2026
+
+This file contains thin wrappers around SSE2/AVX2 registers that let the
+graphics pipe emulator's rasterization kernels be written once for however
+many pixels the target processes per instruction:
+- SIMD::width = 8 when the project is built with /arch:AVX2,
+- SIMD::width = 4 on x64 and /arch:SSE2 Win32 builds,
+- SIMD::width = 1 (plain scalars) everywhere else.
+Only the handful of operations the kernels need are wrapped.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef SIMD_H
+#define SIMD_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// widest SIMD instruction set the kernels may use, MSVC only defines
+// __AVX2__ (with /arch:AVX2) so SSE2 is detected from the target instead
+#if defined(__AVX2__)
+#define GLPBO_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLPBO_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace SIMD
+{
+#if defined(GLPBO_SIMD_AVX2)
+	constexpr int width = 8;
+
+	struct Int { __m256i v; };		/*!< 8 x int32, also used as lane mask */
+	struct Float { __m256 v; };		/*!< 8 x float */
+
+	inline Int Set1(int32_t a) { return { _mm256_set1_epi32(a) }; }
+	inline Float Set1(float a) { return { _mm256_set1_ps(a) }; }
+	// {0, 1, ..., width - 1}
+	inline Int LaneIndex() { return { _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) }; }
+	// {a, a + step, ..., a + (width - 1) * step}, caller keeps every lane in int32 range
+	inline Int Ramp(int32_t a, int32_t step) { return { _mm256_setr_epi32(a, a + step, a + 2 * step, a + 3 * step, a + 4 * step, a + 5 * step, a + 6 * step, a + 7 * step) }; }
+
+	inline Int operator+(Int a, Int b) { return { _mm256_add_epi32(a.v, b.v) }; }
+	inline Int operator&(Int a, Int b) { return { _mm256_and_si256(a.v, b.v) }; }
+	inline Int operator|(Int a, Int b) { return { _mm256_or_si256(a.v, b.v) }; }
+	inline Int operator>(Int a, Int b) { return { _mm256_cmpgt_epi32(a.v, b.v) }; }
+	inline Int operator<<(Int a, int n) { return { _mm256_slli_epi32(a.v, n) }; }
+	inline Int operator>>(Int a, int n) { return { _mm256_srli_epi32(a.v, n) }; }
+
+	inline Float operator+(Float a, Float b) { return { _mm256_add_ps(a.v, b.v) }; }
+	inline Float operator-(Float a, Float b) { return { _mm256_sub_ps(a.v, b.v) }; }
+	inline Float operator*(Float a, Float b) { return { _mm256_mul_ps(a.v, b.v) }; }
+	inline Float operator/(Float a, Float b) { return { _mm256_div_ps(a.v, b.v) }; }
+	inline Float Min(Float a, Float b) { return { _mm256_min_ps(a.v, b.v) }; }
+	inline Float Max(Float a, Float b) { return { _mm256_max_ps(a.v, b.v) }; }
+	inline Float Sqrt(Float a) { return { _mm256_sqrt_ps(a.v) }; }
+	inline Int operator>(Float a, Float b) { return { _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)) }; }
+	inline Int operator>=(Float a, Float b) { return { _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)) }; }
+	inline Int operator<(Float a, Float b) { return { _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)) }; }
+	inline Float ToFloat(Int a) { return { _mm256_cvtepi32_ps(a.v) }; }
+	// truncates toward zero like a C cast
+	inline Int Truncate(Float a) { return { _mm256_cvttps_epi32(a.v) }; }
+	// reinterprets the bits of each lane
+	inline Int AsInt(Float a) { return { _mm256_castps_si256(a.v) }; }
+	inline Float AsFloat(Int a) { return { _mm256_castsi256_ps(a.v) }; }
+
+	inline bool Any(Int mask) { return !_mm256_testz_si256(mask.v, mask.v); }
+	inline bool All(Int mask) { return _mm256_movemask_epi8(mask.v) == -1; }
+	// one bit per lane, lane 0 in bit 0
+	inline int Bits(Int mask) { return _mm256_movemask_ps(_mm256_castsi256_ps(mask.v)); }
+
+	// writes the lanes of v whose mask is set to p[0 .. width - 1], other
+	// pixels are neither read nor written
+	inline void MaskStore(uint32_t* p, Int mask, Int v) { _mm256_maskstore_epi32(reinterpret_cast<int*>(p), mask.v, v.v); }
+	inline void MaskStore(float* p, Int mask, Float v) { _mm256_maskstore_ps(p, mask.v, v.v); }
+	// reads the lanes whose mask is set from p[0 .. width - 1], other lanes are 0
+	inline Float MaskLoad(float const* p, Int mask) { return { _mm256_maskload_ps(p, mask.v) }; }
+	// p[0 .. width - 1], p needs no particular alignment
+	inline Float Load(float const* p) { return { _mm256_loadu_ps(p) }; }
+	inline void Store(float* p, Float v) { _mm256_storeu_ps(p, v.v); }
+	inline Int Load(uint32_t const* p) { return { _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)) }; }
+	inline void Store(uint32_t* p, Int v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v.v); }
+	// non-temporal store past the cache, p aligned to 32 bytes
+	inline void Stream(uint32_t* p, Int v) { _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v.v); }
+	// orders earlier Stream()s before any later store
+	inline void Fence() { _mm_sfence(); }
+	// base[index] of each lane
+	inline Int Gather(int32_t const* base, Int index) { return { _mm256_i32gather_epi32(base, index.v, 4) }; }
+
+#elif defined(GLPBO_SIMD_SSE2)
+	constexpr int width = 4;
+
+	struct Int { __m128i v; };		/*!< 4 x int32, also used as lane mask */
+	struct Float { __m128 v; };		/*!< 4 x float */
+
+	inline Int Set1(int32_t a) { return { _mm_set1_epi32(a) }; }
+	inline Float Set1(float a) { return { _mm_set1_ps(a) }; }
+	inline Int LaneIndex() { return { _mm_setr_epi32(0, 1, 2, 3) }; }
+	inline Int Ramp(int32_t a, int32_t step) { return { _mm_setr_epi32(a, a + step, a + 2 * step, a + 3 * step) }; }
+
+	inline Int operator+(Int a, Int b) { return { _mm_add_epi32(a.v, b.v) }; }
+	inline Int operator&(Int a, Int b) { return { _mm_and_si128(a.v, b.v) }; }
+	inline Int operator|(Int a, Int b) { return { _mm_or_si128(a.v, b.v) }; }
+	inline Int operator>(Int a, Int b) { return { _mm_cmpgt_epi32(a.v, b.v) }; }
+	inline Int operator<<(Int a, int n) { return { _mm_slli_epi32(a.v, n) }; }
+	inline Int operator>>(Int a, int n) { return { _mm_srli_epi32(a.v, n) }; }
+
+	inline Float operator+(Float a, Float b) { return { _mm_add_ps(a.v, b.v) }; }
+	inline Float operator-(Float a, Float b) { return { _mm_sub_ps(a.v, b.v) }; }
+	inline Float operator*(Float a, Float b) { return { _mm_mul_ps(a.v, b.v) }; }
+	inline Float operator/(Float a, Float b) { return { _mm_div_ps(a.v, b.v) }; }
+	inline Float Min(Float a, Float b) { return { _mm_min_ps(a.v, b.v) }; }
+	inline Float Max(Float a, Float b) { return { _mm_max_ps(a.v, b.v) }; }
+	inline Float Sqrt(Float a) { return { _mm_sqrt_ps(a.v) }; }
+	inline Int operator>(Float a, Float b) { return { _mm_castps_si128(_mm_cmpgt_ps(a.v, b.v)) }; }
+	inline Int operator>=(Float a, Float b) { return { _mm_castps_si128(_mm_cmpge_ps(a.v, b.v)) }; }
+	inline Int operator<(Float a, Float b) { return { _mm_castps_si128(_mm_cmplt_ps(a.v, b.v)) }; }
+	inline Float ToFloat(Int a) { return { _mm_cvtepi32_ps(a.v) }; }
+	inline Int Truncate(Float a) { return { _mm_cvttps_epi32(a.v) }; }
+	inline Int AsInt(Float a) { return { _mm_castps_si128(a.v) }; }
+	inline Float AsFloat(Int a) { return { _mm_castsi128_ps(a.v) }; }
+
+	inline bool Any(Int mask) { return _mm_movemask_epi8(mask.v) != 0; }
+	inline bool All(Int mask) { return _mm_movemask_epi8(mask.v) == 0xFFFF; }
+	inline int Bits(Int mask) { return _mm_movemask_ps(_mm_castsi128_ps(mask.v)); }
+
+	// SSE2 has no masked store and a read-modify-write could race with the
+	// thread that owns the neighbouring tile, partial masks store per lane
+	inline void MaskStore(uint32_t* p, Int mask, Int v)
+	{
+		int bits = _mm_movemask_ps(_mm_castsi128_ps(mask.v));
+		if (bits == 0xF)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v.v);
+			return;
+		}
+		alignas(16) uint32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), v.v);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (bits & (1 << i))
+			{
+				p[i] = lanes[i];
+			}
+		}
+	}
+	inline void MaskStore(float* p, Int mask, Float v) { MaskStore(reinterpret_cast<uint32_t*>(p), mask, Int{ _mm_castps_si128(v.v) }); }
+	inline Float MaskLoad(float const* p, Int mask)
+	{
+		int bits = _mm_movemask_ps(_mm_castsi128_ps(mask.v));
+		if (bits == 0xF)
+		{
+			return { _mm_loadu_ps(p) };
+		}
+		alignas(16) float lanes[4] = {};
+		for (int i = 0; i < 4; ++i)
+		{
+			if (bits & (1 << i))
+			{
+				lanes[i] = p[i];
+			}
+		}
+		return { _mm_load_ps(lanes) };
+	}
+	inline Float Load(float const* p) { return { _mm_loadu_ps(p) }; }
+	inline void Store(float* p, Float v) { _mm_storeu_ps(p, v.v); }
+	inline Int Load(uint32_t const* p) { return { _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)) }; }
+	inline void Store(uint32_t* p, Int v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v.v); }
+	inline void Stream(uint32_t* p, Int v) { _mm_stream_si128(reinterpret_cast<__m128i*>(p), v.v); }
+	inline void Fence() { _mm_sfence(); }
+	// SSE2 has no gather, lanes are loaded one at a time
+	inline Int Gather(int32_t const* base, Int index)
+	{
+		alignas(16) int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), index.v);
+		return { _mm_setr_epi32(base[lanes[0]], base[lanes[1]], base[lanes[2]], base[lanes[3]]) };
+	}
+
+#else
+	constexpr int width = 1;
+
+	struct Int { int32_t v; };
+	struct Float { float v; };
+
+	inline Int Set1(int32_t a) { return { a }; }
+	inline Float Set1(float a) { return { a }; }
+	inline Int LaneIndex() { return { 0 }; }
+	inline Int Ramp(int32_t a, int32_t) { return { a }; }
+
+	inline Int operator+(Int a, Int b) { return { a.v + b.v }; }
+	inline Int operator&(Int a, Int b) { return { a.v & b.v }; }
+	inline Int operator|(Int a, Int b) { return { a.v | b.v }; }
+	inline Int operator>(Int a, Int b) { return { a.v > b.v ? -1 : 0 }; }
+	inline Int operator<<(Int a, int n) { return { static_cast<int32_t>(static_cast<uint32_t>(a.v) << n) }; }
+	inline Int operator>>(Int a, int n) { return { static_cast<int32_t>(static_cast<uint32_t>(a.v) >> n) }; }
+
+	inline Float operator+(Float a, Float b) { return { a.v + b.v }; }
+	inline Float operator-(Float a, Float b) { return { a.v - b.v }; }
+	inline Float operator*(Float a, Float b) { return { a.v * b.v }; }
+	inline Float operator/(Float a, Float b) { return { a.v / b.v }; }
+	inline Float Min(Float a, Float b) { return { a.v < b.v ? a.v : b.v }; }
+	inline Float Max(Float a, Float b) { return { a.v > b.v ? a.v : b.v }; }
+	inline Float Sqrt(Float a) { return { std::sqrt(a.v) }; }
+	inline Int operator>(Float a, Float b) { return { a.v > b.v ? -1 : 0 }; }
+	inline Int operator>=(Float a, Float b) { return { a.v >= b.v ? -1 : 0 }; }
+	inline Int operator<(Float a, Float b) { return { a.v < b.v ? -1 : 0 }; }
+	inline Float ToFloat(Int a) { return { static_cast<float>(a.v) }; }
+	inline Int Truncate(Float a) { return { static_cast<int32_t>(a.v) }; }
+	inline Int AsInt(Float a) { Int r; std::memcpy(&r.v, &a.v, sizeof(r.v)); return r; }
+	inline Float AsFloat(Int a) { Float r; std::memcpy(&r.v, &a.v, sizeof(r.v)); return r; }
+
+	inline bool Any(Int mask) { return mask.v != 0; }
+	inline bool All(Int mask) { return mask.v != 0; }
+	inline int Bits(Int mask) { return mask.v != 0 ? 1 : 0; }
+
+	inline void MaskStore(uint32_t* p, Int mask, Int v)
+	{
+		if (mask.v)
+		{
+			*p = static_cast<uint32_t>(v.v);
+		}
+	}
+	inline void MaskStore(float* p, Int mask, Float v)
+	{
+		if (mask.v)
+		{
+			*p = v.v;
+		}
+	}
+	inline Float MaskLoad(float const* p, Int mask) { return { mask.v ? *p : 0.f }; }
+	inline Float Load(float const* p) { return { *p }; }
+	inline void Store(float* p, Float v) { *p = v.v; }
+	inline Int Load(uint32_t const* p) { return { static_cast<int32_t>(*p) }; }
+	inline void Store(uint32_t* p, Int v) { *p = static_cast<uint32_t>(v.v); }
+	inline void Stream(uint32_t* p, Int v) { *p = static_cast<uint32_t>(v.v); }
+	inline void Fence() {}
+	inline Int Gather(int32_t const* base, Int index) { return { base[index.v] }; }
+#endif
+
+	/*!
+	 * @brief ___SIMD::PackColor___
+	 * ****************************************************************************************************
+	 * Truncates r, g, b float lanes to bytes the way (GLubyte) does and packs
+	 * them into opaque RGBA pixels.
+	 * ****************************************************************************************************
+	*/
+	inline Int PackColor(Float r, Float g, Float b)
+	{
+		Int byte = Set1(0xFF);
+		return (Truncate(r) & byte) | ((Truncate(g) & byte) << 8) | ((Truncate(b) & byte) << 16) | Set1(static_cast<int32_t>(0xFF000000));
+	}
+
+	/*!
+	 * @brief ___SIMD::Floor___
+	 * ****************************************************************************************************
+	 * Rounds lanes in int32 range towards negative infinity. SSE2 has no
+	 * floor, so the truncated value is stepped down where truncation rounded
+	 * up, a compare mask is -1 in those lanes.
+	 * ****************************************************************************************************
+	*/
+	inline Float Floor(Float a)
+	{
+		Float t = ToFloat(Truncate(a));
+		return t + ToFloat(t > a);
+	}
+
+	/*!
+	 * @brief ___SIMD::Log2___
+	 * ****************************************************************************************************
+	 * Approximate log2 of positive lanes: the exponent bits plus a quadratic
+	 * fit of log2 over the mantissa in [1, 2), within 0.005 of the exact
+	 * value and monotonic. Denormals and zero give about -127.
+	 * ****************************************************************************************************
+	*/
+	inline Float Log2(Float a)
+	{
+		Int bits = AsInt(a);
+		Float e = ToFloat(bits >> 23) - Set1(127.f);
+		Float m = AsFloat((bits & Set1(0x007FFFFF)) | Set1(0x3F800000));
+		return e + (Set1(-0.34484843f) * m + Set1(2.02466578f)) * m - Set1(1.67487759f);
+	}
+}
+
+#endif /* SIMD_H */
@@ -0,0 +1,87 @@
+/* !
+@file    threadpool.h
+@author  z.tay@digipen.edu
+@date    17/10/2026
+
+This file contains the declaration of class ThreadPool, a small pool of
+persistent worker threads used by the graphics pipe emulator to spread
+rasterization work (one screen tile per task) across all cores.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                      guard
+----------------------------------------------------------------------------- */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*  _________________________________________________________________________ */
+class ThreadPool
+/*! ThreadPool class.
+Workers are created once and sleep until ParallelFor() hands them a batch of
+tasks. The calling thread takes part in the batch as well, so a pool created
+with thread_cnt workers runs on thread_cnt + 1 threads.
+*/
+{
+public:
+
+  /*!
+   * @brief ___ThreadPool::ThreadPool___
+   * ****************************************************************************************************
+   * Spawns the worker threads.
+   * ****************************************************************************************************
+   * @param thread_cnt
+   * : Number of workers, the calling thread is not included.
+   * ****************************************************************************************************
+  */
+  explicit ThreadPool(unsigned thread_cnt);
+
+  // joins all workers
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  /*!
+   * @brief ___ThreadPool::ParallelFor___
+   * ****************************************************************************************************
+   * Runs task(i) for every i in [0, count) on the workers and the calling
+   * thread, and returns once every task has completed. Tasks are handed out
+   * in increasing order but may finish in any order.
+   * ****************************************************************************************************
+   * @param count
+   * : Number of tasks.
+   * @param task
+   * : Function to call with each task index.
+   * ****************************************************************************************************
+  */
+  void ParallelFor(unsigned count, std::function<void(unsigned)> const& task);
+
+  // number of threads that execute a batch, including the caller
+  unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+private:
+  void WorkerLoop();
+  void RunTasks();
+
+  std::vector<std::thread>                workers;
+  std::mutex                              mtx;
+  std::condition_variable                 cv_start;   /*!< signalled when a batch is posted */
+  std::condition_variable                 cv_done;    /*!< signalled when the last worker leaves a batch */
+  std::function<void(unsigned)> const*    task{ nullptr };
+  unsigned                                task_cnt{ 0 };
+  std::atomic<unsigned>                   next_task{ 0 };
+  unsigned                                generation{ 0 };  /*!< batch counter, wakes workers */
+  unsigned                                busy{ 0 };        /*!< workers still inside current batch */
+  bool                                    quit{ false };
+};
+
+#endif /* THREADPOOL_H */
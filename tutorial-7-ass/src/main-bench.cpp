@@ -0,0 +1,1032 @@
+/*!
+@file    main-bench.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file benchmarks the graphics pipe emulator's kernels in isolation,
+drawing into a HostRenderTarget without a window or an OpenGL context:
+- render_triangle (flat and smooth) and render_triangle_wireframe on tiny
+  (< 4 pixels), medium, huge and sliver triangles,
+- render_linebresenham on lines of every octant,
+- textured quads rotated in screen space, sampling a linear and a Morton
+  layout of the same texture,
+- clear_color_buffer at several resolutions, and with -blocks the detile
+  of resolve_tiles() with nothing binned,
+- draw_elements of smooth shaded spheres from a few thousand triangles up
+  to -mesh triangles, quadrupling, to see how the whole pipeline scales.
+  Spheres with more than 65536 vertices have 32-bit indices, the smaller
+  ones are drawn with 16-bit and, for comparison, 32-bit indices.
+Every case draws a fixed, seeded set of primitives a number of times and
+reports the best and median time, ns per primitive, pixels per second and
+cycles per pixel. Results are printed and saved as JSON so runs can be
+compared:
+
+  tutorial-7-bench [options]
+
+  -iterations N timed repetitions of every case, default 10
+  -size W H     render target size for triangles and lines, default 1800 1800
+  -filter TEXT  only run the cases whose name contains TEXT
+  -mesh N       triangles of the largest sphere, default 2000000
+  -tiled        GLPbo::tiled, each repetition includes resolve_tiles()
+  -fixed        GLPbo::fixed_point
+  -depth        GLPbo::depth_test, the depth buffer is cleared between
+                repetitions (not timed)
+  -blocks       GLPbo::block_layout, every repetition includes the detile
+                in resolve_tiles()
+  -fastclear    GLPbo::fast_clear, clears include the fills of
+                resolve_tiles(). Off by default, as draws would then pay
+                for filling the tiles they touch first.
+  -noclusters   clear GLPbo::cluster_culling, spheres are drawn without
+                rejecting the meshlets that face away first
+  -out PATH     JSON file to write, default bench.json
+
+Pixel counts of filled triangles are their areas, of lines and wireframes
+the number of pixels Bresenham visits. Cycles are time stamp counter ticks,
+which run at the processor's base frequency rather than its current one,
+and are not measured on processors without a time stamp counter.
+
+Texture cases also report cache misses per pixel. Hardware counters are
+not portable, so the misses are simulated: the texels each pixel filters
+are replayed in scanline order through a model of a 32 KiB, 8-way L1 data
+cache with 64 byte lines. Tiled runs visit pixels in a different order
+than the model does.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glpbo.h>
+#include <meshopt.h>
+#include <rendertarget.h>
+#include <shaders.h>
+#include <simd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BENCH_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC
+#endif
+
+/*                                                         type declarations
+----------------------------------------------------------------------------- */
+/*!
+ * @brief ___Options___
+ * *********************
+ * Command line options, see the file header.
+*/
+struct Options
+{
+	int			iterations = 10;
+	GLsizei		width = 1800, height = 1800;
+	std::string	filter;
+	size_t		mesh = 2000000;
+	std::string	out = "bench.json";
+};
+
+/*!
+ * @brief ___Triangle___
+ * *********************
+ * Window coordinates and vertex colors of a benchmark triangle.
+*/
+struct Triangle
+{
+	glm::vec3	p0, p1, p2;
+	glm::vec3	c0, c1, c2;
+};
+
+/*!
+ * @brief ___Line___
+ * *********************
+ * End points of a benchmark line.
+*/
+struct Line
+{
+	GLint		x0, y0, x1, y1;
+};
+
+/*!
+ * @brief ___Quad___
+ * *********************
+ * A square of textured pixels rotated about its center. Texture
+ * coordinates run along its unrotated sides, scale texels per pixel.
+*/
+struct Quad
+{
+	glm::vec2	center;
+	float		half = 0.f;			/*!< half the side in pixels */
+	float		angle = 0.f;		/*!< counterclockwise, radians */
+	float		scale = 1.f;		/*!< level 0 texels per pixel */
+};
+
+/*!
+ * @brief ___CacheModel___
+ * *********************
+ * Set associative cache with LRU replacement, counts misses of the
+ * addresses it is given.
+*/
+class CacheModel
+{
+public:
+	CacheModel(size_t bytes, size_t ways, size_t line) :
+		ways_(ways), line_(line), sets_(bytes / (ways * line)) {}
+
+	void Access(uintptr_t address)
+	{
+		uintptr_t tag = address / line_;
+		std::list<uintptr_t>& set = sets_[tag % sets_.size()];
+		auto hit = std::find(set.begin(), set.end(), tag);
+		if (hit != set.end())
+		{
+			set.splice(set.begin(), set, hit);
+			return;
+		}
+		++misses;
+		set.push_front(tag);
+		if (set.size() > ways_)
+		{
+			set.pop_back();
+		}
+	}
+
+	size_t	misses = 0;
+
+private:
+	size_t							ways_, line_;
+	std::vector<std::list<uintptr_t>>	sets_;		/*!< most recently used first */
+};
+
+/*!
+ * @brief ___Case___
+ * *********************
+ * One benchmark: run() draws primitive_cnt primitives that cover
+ * pixel_cnt pixels. setup() runs before every repetition and is not timed.
+ * Cases that touch textures also get their simulated cache misses.
+*/
+struct Case
+{
+	std::string				name;
+	std::string				kernel;
+	size_t					primitive_cnt = 0;
+	double					pixel_cnt = 0.0;
+	double					misses_per_pixel = -1.0;	/*!< negative if not simulated */
+	std::function<void()>	setup;
+	std::function<void()>	run;
+};
+
+/*!
+ * @brief ___Result___
+ * *********************
+ * Timings of a case, over all repetitions.
+*/
+struct Result
+{
+	double		best_ns = 0.0, median_ns = 0.0;
+	double		best_cycles = 0.0;
+};
+
+/*                                                      function declarations
+----------------------------------------------------------------------------- */
+static bool parse_args(int argc, char** argv, Options& opt);
+static std::vector<Triangle> make_triangles(std::string const& shape, size_t count, GLsizei w, GLsizei h, std::mt19937& rng);
+static std::vector<Line> make_lines(int octant, size_t count, GLint length, GLsizei w, GLsizei h, std::mt19937& rng);
+static double bresenham_pixels(GLint x0, GLint y0, GLint x1, GLint y1);
+static std::shared_ptr<GLPbo::Model> make_sphere(size_t triangles, float radius);
+static std::shared_ptr<GLPbo::Texture> make_texture(GLsizei size, GLPbo::Texture::Layout layout);
+static void draw_quad(Quad const& q, Shaders::Textured const& shader, GLsizei size);
+static double simulate_misses(Quad const& q, GLPbo::Texture const& t, GLPbo::Texture::Filter filter);
+static Result run_case(Case const& c, int iterations);
+static uint64_t read_tsc();
+static bool write_json(std::string const& path, Options const& opt, std::vector<Case> const& cases, std::vector<Result> const& results);
+
+/*                                                      function definitions
+----------------------------------------------------------------------------- */
+/*  _________________________________________________________________________ */
+/*! main
+
+@param argc, argv
+Options, see the file header.
+
+@return int
+0 if every case ran and the JSON file was written, 1 otherwise.
+*/
+int main(int argc, char** argv)
+{
+	Options opt;
+	GLPbo::fast_clear = false;
+	if (!parse_args(argc, argv, opt))
+	{
+		return EXIT_FAILURE;
+	}
+
+	GLPbo::init_rasterizer(opt.width, opt.height);
+	HostRenderTarget target(opt.width, opt.height);
+	GLPbo::ptr_to_pbo = target.Map();
+
+	// every repetition starts from cleared buffers, as a frame would
+	auto clear_buffers = []
+	{
+		GLPbo::clear_color_buffer();
+		if (GLPbo::depth_test)
+		{
+			GLPbo::clear_depth_buffer();
+		}
+	};
+
+	std::vector<Case> cases;
+	std::mt19937 rng(2100);
+
+	// filled and wireframe triangles of every shape
+	struct Shape { char const* name; size_t count; };
+	Shape const shapes[] = { { "tiny", 200000 }, { "medium", 20000 }, { "huge", 20 }, { "sliver", 5000 } };
+	for (Shape const& shape : shapes)
+	{
+		auto tris = std::make_shared<std::vector<Triangle>>(make_triangles(shape.name, shape.count, opt.width, opt.height, rng));
+		double area = 0.0, perimeter = 0.0;
+		for (Triangle const& t : *tris)
+		{
+			glm::vec3 e1 = t.p1 - t.p0, e2 = t.p2 - t.p0;
+			area += 0.5 * std::abs(static_cast<double>(e1.x) * e2.y - static_cast<double>(e1.y) * e2.x);
+			glm::vec3 const* p[] = { &t.p0, &t.p1, &t.p2 };
+			for (int i = 0; i < 3; ++i)
+			{
+				glm::vec3 const& a = *p[i];
+				glm::vec3 const& b = *p[(i + 1) % 3];
+				perimeter += bresenham_pixels(static_cast<GLint>(a.x), static_cast<GLint>(a.y), static_cast<GLint>(b.x), static_cast<GLint>(b.y));
+			}
+		}
+
+		Case flat;
+		flat.name = std::string("triangle_flat_") + shape.name;
+		flat.kernel = "render_triangle";
+		flat.primitive_cnt = tris->size();
+		flat.pixel_cnt = area;
+		flat.setup = clear_buffers;
+		flat.run = [tris]
+		{
+			for (Triangle const& t : *tris)
+			{
+				GLPbo::render_triangle(t.p0, t.p1, t.p2, t.c0);
+			}
+			GLPbo::resolve_tiles();
+		};
+		cases.push_back(flat);
+
+		Case smooth = flat;
+		smooth.name = std::string("triangle_smooth_") + shape.name;
+		smooth.run = [tris]
+		{
+			for (Triangle const& t : *tris)
+			{
+				GLPbo::render_triangle(t.p0, t.p1, t.p2, t.c0, t.c1, t.c2);
+			}
+			GLPbo::resolve_tiles();
+		};
+		cases.push_back(smooth);
+
+		Case wire = flat;
+		wire.name = std::string("triangle_wireframe_") + shape.name;
+		wire.kernel = "render_triangle_wireframe";
+		wire.pixel_cnt = perimeter;
+		wire.run = [tris]
+		{
+			for (Triangle const& t : *tris)
+			{
+				GLPbo::render_triangle_wireframe(t.p0, t.p1, t.p2, { 0, 0, 0, 255 });
+			}
+			GLPbo::resolve_tiles();
+		};
+		cases.push_back(wire);
+	}
+
+	// lines of every octant, octant 0 runs from the +x axis to the diagonal
+	for (int octant = 0; octant < 8; ++octant)
+	{
+		auto lines = std::make_shared<std::vector<Line>>(make_lines(octant, 20000, 256, opt.width, opt.height, rng));
+		double pixels = 0.0;
+		for (Line const& l : *lines)
+		{
+			pixels += bresenham_pixels(l.x0, l.y0, l.x1, l.y1);
+		}
+
+		Case line;
+		line.name = "line_octant" + std::to_string(octant);
+		line.kernel = "render_linebresenham";
+		line.primitive_cnt = lines->size();
+		line.pixel_cnt = pixels;
+		line.setup = clear_buffers;
+		line.run = [lines]
+		{
+			for (Line const& l : *lines)
+			{
+				GLPbo::render_linebresenham(l.x0, l.y0, l.x1, l.y1, { 0, 0, 0, 255 });
+			}
+			GLPbo::resolve_tiles();
+		};
+		cases.push_back(line);
+	}
+
+	// textured quads turned 0, 30, 45 and 90 degrees in screen space, one
+	// texel per pixel with bilinear filtering and 4 texels per pixel with
+	// trilinear filtering, sampling a texture 16 MiB at level 0 in both
+	// layouts. Turned 90 degrees, a linear texture is read a row per pixel.
+	GLsizei const texture_size = 2048;
+	std::shared_ptr<GLPbo::Texture> textures[] = {
+		make_texture(texture_size, GLPbo::Texture::Layout::Linear),
+		make_texture(texture_size, GLPbo::Texture::Layout::Morton) };
+	int const angles[] = { 0, 30, 45, 90 };
+	struct Sampling { char const* name; GLPbo::Texture::Filter filter; float scale; };
+	Sampling const samplings[] = {
+		{ "bilinear", GLPbo::Texture::Filter::Bilinear, 1.f },
+		{ "trilinear", GLPbo::Texture::Filter::Trilinear, 4.f } };
+	for (Sampling const& sampling : samplings)
+	{
+		for (int angle : angles)
+		{
+			for (auto const& texture : textures)
+			{
+				Quad q;
+				q.center = { opt.width * 0.5f, opt.height * 0.5f };
+				q.half = 0.3f * std::min(opt.width, opt.height);
+				q.angle = angle * 0.01745329f;
+				q.scale = sampling.scale;
+				Shaders::Textured shader;
+				shader.texture = texture.get();
+				shader.filter = sampling.filter;
+
+				Case quad;
+				bool morton = texture->layout == GLPbo::Texture::Layout::Morton;
+				quad.name = std::string("texture_") + sampling.name + (morton ? "_morton" : "_linear") + "_rot" + std::to_string(angle);
+				if (quad.name.find(opt.filter) == std::string::npos)
+				{
+					continue;
+				}
+				quad.kernel = "render_triangle<Shaders::Textured>";
+				quad.primitive_cnt = 2;
+				quad.pixel_cnt = 4.0 * q.half * q.half;
+				quad.misses_per_pixel = simulate_misses(q, *texture, sampling.filter) / quad.pixel_cnt;
+				quad.setup = clear_buffers;
+				quad.run = [q, shader, texture_size, texture]
+				{
+					draw_quad(q, shader, texture_size);
+					GLPbo::resolve_tiles();
+				};
+				cases.push_back(quad);
+			}
+		}
+	}
+
+	// spheres of the whole indexed pipeline, the front half covers a disk
+	float const radius = 0.9f;
+	for (size_t tris = opt.mesh; tris >= 4096; tris /= 4)
+	{
+		std::string name = "mesh_" + std::to_string(tris);
+		if ((name + "_16bit").find(opt.filter) == std::string::npos && (name + "_32bit").find(opt.filter) == std::string::npos)
+		{
+			continue;
+		}
+		std::shared_ptr<GLPbo::Model> sphere = make_sphere(tris, radius);
+		std::vector<std::shared_ptr<GLPbo::Model>> models;
+		models.reserve(2);
+		models.push_back(sphere);
+		if (sphere->tri32.empty())
+		{
+			auto wide = std::make_shared<GLPbo::Model>(*sphere);
+			wide->tri32.assign(wide->tri.begin(), wide->tri.end());
+			wide->tri.clear();
+			models.push_back(std::move(wide));
+		}
+		for (auto const& model : models)
+		{
+			Case mesh;
+			mesh.name = name + (model->tri32.empty() ? "_16bit" : "_32bit");
+			mesh.kernel = "draw_elements";
+			mesh.primitive_cnt = model->triangle_cnt();
+			mesh.pixel_cnt = 3.14159265 * radius * radius * 0.25 * opt.width * opt.height;
+			mesh.setup = clear_buffers;
+			mesh.run = [model]
+			{
+				GLPbo::DrawState state;
+				GLPbo::draw_elements(*model, GLPbo::DrawMode::SmoothShaded, state);
+				GLPbo::resolve_tiles();
+			};
+			cases.push_back(mesh);
+		}
+	}
+
+	std::vector<Case> selected;
+	for (Case const& c : cases)
+	{
+		if (c.name.find(opt.filter) != std::string::npos)
+		{
+			selected.push_back(c);
+		}
+	}
+
+	std::vector<Result> results;
+	std::cout << std::left << std::setw(40) << "case" << std::right
+		<< std::setw(10) << "prims" << std::setw(14) << "ns/prim"
+		<< std::setw(14) << "Mpixels/s" << std::setw(12) << "cycles/px" << std::setw(12) << "misses/px" << std::endl;
+	auto report = [&results](Case const& c)
+	{
+		Result const& r = results.back();
+		std::cout << std::left << std::setw(40) << c.name << std::right << std::fixed
+			<< std::setw(10) << c.primitive_cnt
+			<< std::setw(14) << std::setprecision(2) << r.best_ns / c.primitive_cnt
+			<< std::setw(14) << std::setprecision(1) << c.pixel_cnt / r.best_ns * 1e3
+			<< std::setw(12) << std::setprecision(3) << r.best_cycles / c.pixel_cnt;
+		if (c.misses_per_pixel >= 0.0)
+		{
+			std::cout << std::setw(12) << std::setprecision(3) << c.misses_per_pixel;
+		}
+		std::cout << std::endl;
+	};
+	for (Case const& c : selected)
+	{
+		results.push_back(run_case(c, opt.iterations));
+		report(c);
+	}
+
+	// clears and detiles at several resolutions, each gets its own target
+	// and buffers
+	GLsizei const resolutions[][2] = { { 256, 256 }, { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+	for (auto const& res : resolutions)
+	{
+		std::string size = std::to_string(res[0]) + "x" + std::to_string(res[1]);
+		Case clear;
+		clear.name = "clear_" + size;
+		clear.kernel = "clear_color_buffer";
+		clear.primitive_cnt = 1;
+		clear.pixel_cnt = static_cast<double>(res[0]) * res[1];
+		clear.setup = [] {};
+		clear.run = []
+		{
+			GLPbo::clear_color_buffer();
+			if (GLPbo::fast_clear)
+			{
+				GLPbo::resolve_tiles();
+			}
+		};
+
+		Case detile = clear;
+		detile.name = "detile_" + size;
+		detile.kernel = "resolve_tiles";
+		detile.run = [] { GLPbo::resolve_tiles(); };
+
+		std::vector<Case> sized = { clear };
+		if (GLPbo::block_layout)
+		{
+			sized.push_back(detile);
+		}
+		GLPbo::init_rasterizer(res[0], res[1]);
+		HostRenderTarget sized_target(res[0], res[1]);
+		GLPbo::ptr_to_pbo = sized_target.Map();
+		for (Case const& c : sized)
+		{
+			if (c.name.find(opt.filter) == std::string::npos)
+			{
+				continue;
+			}
+			results.push_back(run_case(c, opt.iterations));
+			report(c);
+			selected.push_back(c);
+		}
+	}
+	GLPbo::ptr_to_pbo = nullptr;
+	GLPbo::cleanup_rasterizer();
+
+	if (!write_json(opt.out, opt, selected, results))
+	{
+		std::cout << "could not write " << opt.out << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*  _________________________________________________________________________ */
+/*! parse_args
+
+@param argc, argv
+Command line.
+
+@param Options&
+opt: filled with the options given, the others keep their defaults.
+
+@return bool
+False, after printing why, if the command line is invalid.
+*/
+static bool parse_args(int argc, char** argv, Options& opt)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		// options that take values check there are enough left
+		auto values = [&](int count) { return i + count < argc; };
+
+		if (arg == "-iterations" && values(1))
+		{
+			opt.iterations = std::atoi(argv[++i]);
+		}
+		else if (arg == "-size" && values(2))
+		{
+			opt.width = std::atoi(argv[++i]);
+			opt.height = std::atoi(argv[++i]);
+		}
+		else if (arg == "-filter" && values(1))
+		{
+			opt.filter = argv[++i];
+		}
+		else if (arg == "-mesh" && values(1))
+		{
+			opt.mesh = static_cast<size_t>(std::atoll(argv[++i]));
+		}
+		else if (arg == "-out" && values(1))
+		{
+			opt.out = argv[++i];
+		}
+		else if (arg == "-tiled")
+		{
+			GLPbo::tiled = true;
+		}
+		else if (arg == "-fixed")
+		{
+			GLPbo::fixed_point = true;
+		}
+		else if (arg == "-depth")
+		{
+			GLPbo::depth_test = true;
+		}
+		else if (arg == "-blocks")
+		{
+			GLPbo::block_layout = true;
+		}
+		else if (arg == "-fastclear")
+		{
+			GLPbo::fast_clear = true;
+		}
+		else if (arg == "-noclusters")
+		{
+			GLPbo::cluster_culling = false;
+		}
+		else
+		{
+			std::cout << "unknown or incomplete option " << arg << std::endl;
+			return false;
+		}
+	}
+
+	// huge triangles and 256 pixel lines need some room
+	if (opt.iterations < 1 || opt.width < 512 || opt.height < 512)
+	{
+		std::cout << "iterations must be positive, size at least 512 x 512" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*  _________________________________________________________________________ */
+/*! make_triangles
+
+@param std::string const&
+shape: "tiny" (aabb under 4 x 4 pixels), "medium" (about 50 pixels across),
+"huge" (about half the screen) or "sliver" (half the screen long, about a
+pixel thick).
+
+@param size_t
+count: how many triangles.
+
+@param GLsizei
+w, h: screen size, every triangle lies within it.
+
+@param std::mt19937&
+rng: random engine.
+
+@return std::vector<Triangle>
+Front facing triangles with random depths and colors in [0, 255].
+*/
+static std::vector<Triangle> make_triangles(std::string const& shape, size_t count, GLsizei w, GLsizei h, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	auto random_color = [&] { return glm::vec3(unit(rng), unit(rng), unit(rng)) * 255.f; };
+	float const fw = static_cast<float>(w), fh = static_cast<float>(h);
+
+	std::vector<Triangle> tris;
+	tris.reserve(count);
+	while (tris.size() < count)
+	{
+		Triangle t;
+		if (shape == "huge")
+		{
+			// one vertex near each of three corners
+			float j = 0.1f;
+			t.p0 = { fw * (0.02f + j * unit(rng)), fh * (0.02f + j * unit(rng)), 0.f };
+			t.p1 = { fw * (0.88f + j * unit(rng)), fh * (0.02f + j * unit(rng)), 0.f };
+			t.p2 = { fw * (0.45f + j * unit(rng)), fh * (0.88f + j * unit(rng)), 0.f };
+		}
+		else if (shape == "sliver")
+		{
+			// half a screen long, 0.5 to 1.5 pixels thick at its widest
+			float length = 0.5f * std::min(fw, fh);
+			float angle = 6.2831853f * unit(rng);
+			glm::vec3 dir(std::cos(angle), std::sin(angle), 0.f), nml(-dir.y, dir.x, 0.f);
+			glm::vec3 center(fw * 0.5f + (unit(rng) - 0.5f) * (fw - length - 4.f), fh * 0.5f + (unit(rng) - 0.5f) * (fh - length - 4.f), 0.f);
+			t.p0 = center - dir * (length * 0.5f);
+			t.p1 = center + dir * (length * 0.5f);
+			t.p2 = center + nml * (0.5f + unit(rng));
+		}
+		else
+		{
+			// vertices within radius of a random center
+			float radius = shape == "tiny" ? 1.5f : 25.f;
+			glm::vec3 center(radius + 1.f + unit(rng) * (fw - 2.f * radius - 2.f), radius + 1.f + unit(rng) * (fh - 2.f * radius - 2.f), 0.f);
+			auto offset = [&] { return glm::vec3((unit(rng) * 2.f - 1.f) * radius, (unit(rng) * 2.f - 1.f) * radius, 0.f); };
+			t.p0 = center + offset();
+			t.p1 = center + offset();
+			t.p2 = center + offset();
+		}
+
+		// skip (near) degenerate triangles, make the others front facing
+		glm::vec3 e1 = t.p1 - t.p0, e2 = t.p2 - t.p0;
+		float area = e1.x * e2.y - e1.y * e2.x;
+		if (std::abs(area) < 0.5f)
+		{
+			continue;
+		}
+		if (area < 0.f)
+		{
+			std::swap(t.p1, t.p2);
+		}
+		t.p0.z = unit(rng);
+		t.p1.z = unit(rng);
+		t.p2.z = unit(rng);
+		t.c0 = random_color();
+		t.c1 = random_color();
+		t.c2 = random_color();
+		tris.push_back(t);
+	}
+	return tris;
+}
+
+/*  _________________________________________________________________________ */
+/*! make_sphere
+
+@param size_t
+triangles: about how many triangles.
+
+@param float
+radius: of the sphere, centered at the origin of NDC.
+
+@return std::shared_ptr<GLPbo::Model>
+Latitude longitude sphere with twice as many slices as stacks, normals
+mapped to [0, 1] like Scene::LoadScene() does, indices set by
+Model::set_triangles() and split by MeshOpt::BuildMeshlets(). The
+triangles at the poles are degenerate.
+*/
+static std::shared_ptr<GLPbo::Model> make_sphere(size_t triangles, float radius)
+{
+	GLuint stacks = std::max(2u, static_cast<GLuint>(std::sqrt(triangles / 4.0) + 0.5));
+	GLuint slices = stacks * 2;
+	float const pi = 3.14159265f;
+
+	auto model = std::make_shared<GLPbo::Model>();
+	for (GLuint i = 0; i <= stacks; ++i)
+	{
+		float phi = pi * i / stacks;
+		for (GLuint j = 0; j <= slices; ++j)
+		{
+			float theta = 2.f * pi * j / slices;
+			glm::vec3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+			model->pm.push_back(n * radius);
+			model->nml.push_back((n + 1.f) * 0.5f);
+			model->tex.push_back({ static_cast<float>(j) / slices, static_cast<float>(i) / stacks });
+		}
+	}
+	std::vector<GLuint> indices;
+	indices.reserve(static_cast<size_t>(stacks) * slices * 6);
+	for (GLuint i = 0; i < stacks; ++i)
+	{
+		for (GLuint j = 0; j < slices; ++j)
+		{
+			GLuint a = i * (slices + 1) + j, b = a + slices + 1;
+			indices.insert(indices.end(), { a, a + 1, b, b, a + 1, b + 1 });
+		}
+	}
+	model->set_triangles(std::move(indices));
+	MeshOpt::BuildMeshlets(*model);
+	return model;
+}
+
+/*  _________________________________________________________________________ */
+/*! make_lines
+
+@param int
+octant: direction of every line, octant k spans angles [45k, 45(k + 1))
+degrees counterclockwise from the +x axis.
+
+@param size_t
+count: how many lines.
+
+@param GLint
+length: length of every line in pixels.
+
+@param GLsizei
+w, h: screen size, every line lies within it.
+
+@param std::mt19937&
+rng: random engine.
+
+@return std::vector<Line>
+Lines with random start points and directions strictly inside the octant.
+*/
+static std::vector<Line> make_lines(int octant, size_t count, GLint length, GLsizei w, GLsizei h, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	std::vector<Line> lines;
+	lines.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		float angle = 0.7853982f * (octant + 0.05f + 0.9f * unit(rng));
+		GLint dx = static_cast<GLint>(std::lround(std::cos(angle) * length));
+		GLint dy = static_cast<GLint>(std::lround(std::sin(angle) * length));
+		// start anywhere the whole line stays on screen
+		GLint x0 = std::max(0, -dx) + static_cast<GLint>(unit(rng) * (w - 1 - std::abs(dx)));
+		GLint y0 = std::max(0, -dy) + static_cast<GLint>(unit(rng) * (h - 1 - std::abs(dy)));
+		lines.push_back({ x0, y0, x0 + dx, y0 + dy });
+	}
+	return lines;
+}
+
+// pixels render_linebresenham() sets for a line, one per step along the
+// major axis, the end point is not drawn
+static double bresenham_pixels(GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	return static_cast<double>(std::max({ std::abs(x1 - x0), std::abs(y1 - y0), 1 }));
+}
+
+/*  _________________________________________________________________________ */
+/*! make_texture
+
+@param GLsizei
+size: width and height, a power of two.
+
+@param GLPbo::Texture::Layout
+layout: order of the texels.
+
+@return std::shared_ptr<GLPbo::Texture>
+A checkerboard of 8 x 8 texel cells with noise in every texel, mip mapped,
+the same texels in both layouts.
+*/
+static std::shared_ptr<GLPbo::Texture> make_texture(GLsizei size, GLPbo::Texture::Layout layout)
+{
+	std::mt19937 rng(4100);
+	std::uniform_int_distribution<int> noise(0, 63);
+	std::vector<GLPbo::Color> image(static_cast<size_t>(size) * size);
+	for (GLsizei y = 0; y < size; ++y)
+	{
+		for (GLsizei x = 0; x < size; ++x)
+		{
+			GLubyte base = ((x >> 3) ^ (y >> 3)) & 1 ? 192 : 32;
+			image[static_cast<size_t>(y) * size + x] = { static_cast<GLubyte>(base + noise(rng)), base, static_cast<GLubyte>(255 - base), 255 };
+		}
+	}
+
+	auto texture = std::make_shared<GLPbo::Texture>();
+	texture->set_image(size, size, std::move(image));
+	texture->build_mipmaps();
+	texture->set_layout(layout);
+	return texture;
+}
+
+// corner i of a quad, counterclockwise from its bottom left, in window
+// coordinates and in level 0 texels
+static void quad_corner(Quad const& q, int i, glm::vec2& window, glm::vec2& texel)
+{
+	glm::vec2 local((i == 1 || i == 2) ? q.half : -q.half, i >= 2 ? q.half : -q.half);
+	float c = std::cos(q.angle), s = std::sin(q.angle);
+	window = q.center + glm::vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+	texel = (local + glm::vec2(q.half)) * q.scale;
+}
+
+// draws a quad as two triangles with a textured shader
+static void draw_quad(Quad const& q, Shaders::Textured const& shader, GLsizei size)
+{
+	GLPbo::Vertex v[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		glm::vec2 window, texel;
+		quad_corner(q, i, window, texel);
+		v[i].p = { window, 0.5f };
+		v[i].v[0] = texel.x / size;
+		v[i].v[1] = texel.y / size;
+	}
+	GLPbo::render_triangle(v[0], v[1], v[2], shader);
+	GLPbo::render_triangle(v[0], v[2], v[3], shader);
+}
+
+/*  _________________________________________________________________________ */
+/*! simulate_misses
+
+@param Quad const&
+q: quad drawn.
+
+@param GLPbo::Texture const&
+t: texture it samples.
+
+@param GLPbo::Texture::Filter
+filter: bilinear reads the 2x2 texels around each pixel's texture
+coordinates in the level nearest to log2(q.scale), trilinear in the two
+levels around it.
+
+@return double
+Misses of a 32 KiB, 8-way, 64 byte line cache over the texels the pixel
+centers of the quad read, in scanline order.
+*/
+static double simulate_misses(Quad const& q, GLPbo::Texture const& t, GLPbo::Texture::Filter filter)
+{
+	CacheModel cache(32 * 1024, 8, 64);
+	float lod = std::min(std::max(std::log2(q.scale), 0.f), static_cast<float>(t.levels - 1));
+	GLint levels[2] = { static_cast<GLint>(lod + 0.5f), 0 };
+	int level_cnt = 1;
+	if (filter == GLPbo::Texture::Filter::Trilinear)
+	{
+		levels[0] = static_cast<GLint>(lod);
+		levels[1] = std::min(levels[0] + 1, t.levels - 1);
+		level_cnt = 2;
+	}
+
+	float c = std::cos(q.angle), s = std::sin(q.angle);
+	GLint extent = static_cast<GLint>(std::ceil(q.half * 1.5f));
+	GLint cx = static_cast<GLint>(q.center.x), cy = static_cast<GLint>(q.center.y);
+	for (GLint y = cy - extent; y < cy + extent; ++y)
+	{
+		for (GLint x = cx - extent; x < cx + extent; ++x)
+		{
+			// back into the quad's unrotated frame
+			glm::vec2 d = glm::vec2(x + 0.5f, y + 0.5f) - q.center;
+			glm::vec2 local(c * d.x + s * d.y, -s * d.x + c * d.y);
+			if (std::abs(local.x) > q.half || std::abs(local.y) > q.half)
+			{
+				continue;
+			}
+			glm::vec2 texel = (local + glm::vec2(q.half)) * q.scale;
+			for (int i = 0; i < level_cnt; ++i)
+			{
+				GLint l = levels[i];
+				float shrink = static_cast<float>(1 << l);
+				int32_t x0 = static_cast<int32_t>(std::floor(texel.x / shrink - 0.5f));
+				int32_t y0 = static_cast<int32_t>(std::floor(texel.y / shrink - 0.5f));
+				int32_t wmask = t.level_width[l] - 1, hmask = t.level_height[l] - 1;
+				for (int k = 0; k < 4; ++k)
+				{
+					size_t index = t.texel_index(l, (x0 + (k & 1)) & wmask, (y0 + (k >> 1)) & hmask);
+					cache.Access(reinterpret_cast<uintptr_t>(t.texels.data() + index));
+				}
+			}
+		}
+	}
+	return static_cast<double>(cache.misses);
+}
+
+/*  _________________________________________________________________________ */
+/*! run_case
+
+@param Case const&
+c: case to run.
+
+@param int
+iterations: timed repetitions, after one untimed warm up.
+
+@return Result
+Best and median time, and the cycles of the best repetition.
+*/
+static Result run_case(Case const& c, int iterations)
+{
+	c.setup();
+	c.run();
+
+	std::vector<double> times;
+	Result result;
+	for (int i = 0; i < iterations; ++i)
+	{
+		c.setup();
+		auto start = std::chrono::steady_clock::now();
+		uint64_t start_tsc = read_tsc();
+		c.run();
+		uint64_t cycles = read_tsc() - start_tsc;
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		if (times.empty() || ns < result.best_ns)
+		{
+			result.best_ns = ns;
+			result.best_cycles = static_cast<double>(cycles);
+		}
+		times.push_back(ns);
+	}
+	std::sort(times.begin(), times.end());
+	result.median_ns = times[times.size() / 2];
+	return result;
+}
+
+// time stamp counter, 0 where there is none
+static uint64_t read_tsc()
+{
+#if defined(BENCH_HAS_TSC)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/*  _________________________________________________________________________ */
+/*! write_json
+
+@param std::string const&
+path: file to write.
+
+@param Options const&
+opt: options the cases ran with.
+
+@param std::vector<Case> const&, std::vector<Result> const&
+cases, results: cases that ran and their results, in the same order.
+
+@return bool
+False if the file could not be written.
+*/
+static bool write_json(std::string const& path, Options const& opt, std::vector<Case> const& cases, std::vector<Result> const& results)
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	bool has_tsc = false;
+#if defined(BENCH_HAS_TSC)
+	has_tsc = true;
+#endif
+	auto boolean = [](bool b) { return b ? "true" : "false"; };
+
+	file << std::setprecision(10);
+	file << "{\n"
+		<< "  \"width\": " << opt.width << ",\n"
+		<< "  \"height\": " << opt.height << ",\n"
+		<< "  \"iterations\": " << opt.iterations << ",\n"
+		<< "  \"mesh\": " << opt.mesh << ",\n"
+		<< "  \"simd_width\": " << SIMD::width << ",\n"
+		<< "  \"tiled\": " << boolean(GLPbo::tiled) << ",\n"
+		<< "  \"fixed_point\": " << boolean(GLPbo::fixed_point) << ",\n"
+		<< "  \"depth_test\": " << boolean(GLPbo::depth_test) << ",\n"
+		<< "  \"block_layout\": " << boolean(GLPbo::block_layout) << ",\n"
+		<< "  \"fast_clear\": " << boolean(GLPbo::fast_clear) << ",\n"
+		<< "  \"cluster_culling\": " << boolean(GLPbo::cluster_culling) << ",\n"
+		<< "  \"cases\": [\n";
+	for (size_t i = 0; i < cases.size(); ++i)
+	{
+		Case const& c = cases[i];
+		Result const& r = results[i];
+		file << "    {\n"
+			<< "      \"name\": \"" << c.name << "\",\n"
+			<< "      \"kernel\": \"" << c.kernel << "\",\n"
+			<< "      \"primitives\": " << c.primitive_cnt << ",\n"
+			<< "      \"pixels\": " << c.pixel_cnt << ",\n"
+			<< "      \"best_ns\": " << r.best_ns << ",\n"
+			<< "      \"median_ns\": " << r.median_ns << ",\n"
+			<< "      \"ns_per_primitive\": " << r.best_ns / c.primitive_cnt << ",\n"
+			<< "      \"pixels_per_second\": " << c.pixel_cnt / r.best_ns * 1e9 << ",\n"
+			<< "      \"cycles_per_pixel\": ";
+		if (has_tsc)
+		{
+			file << r.best_cycles / c.pixel_cnt << ",\n";
+		}
+		else
+		{
+			file << "null,\n";
+		}
+		file << "      \"simulated_misses_per_pixel\": ";
+		if (c.misses_per_pixel >= 0.0)
+		{
+			file << c.misses_per_pixel << "\n";
+		}
+		else
+		{
+			file << "null\n";
+		}
+		file << "    }" << (i + 1 < cases.size() ? "," : "") << "\n";
+	}
+	file << "  ]\n}\n";
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,295 @@
+/*!
+@file    main-eglcheck.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file checks PboRenderTarget against HostRenderTarget without a window,
+on an OpenGL 4.5 core context of Mesa's surfaceless EGL platform, so the
+PBO ring can be tested on machines without a display:
+
+  tutorial-7-eglcheck [options] [scene.scn]
+
+  -frames N     frames streamed after the check, default 100
+  -size W H     render target size, default 601 599, which leaves partial
+                tiles on the right and top edges
+  -blocks       GLPbo::block_layout
+
+The check renders 40 frames of the scene, switching model, draw mode and
+clear color along the way, into a PboRenderTarget, a HostRenderTarget and
+a HostRenderTarget with GLPbo::dirty_tiles cleared, which clears and
+presents every pixel. The PBO ring's texture is read back after each frame
+and the three images must be byte for byte the same. Then N frames are
+streamed through the ring alone and how often and how long Map() waited on
+a fence, and the bytes uploaded, are printed.
+
+Built by CMakeLists.txt with GLPBO_EGL_CHECK on, against the system's GL
+and EGL libraries rather than GLEW.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glpbo.h>
+#include <pborendertarget.h>
+#include <scene.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*                                                         type declarations
+----------------------------------------------------------------------------- */
+/*!
+ * @brief ___Options___
+ * *********************
+ * Command line options, see the file header.
+*/
+struct Options
+{
+	std::string	scene = "../scenes/ass-1.scn";
+	int			frames = 100;
+	GLsizei		width = 601, height = 599;
+};
+
+/*                                                      function declarations
+----------------------------------------------------------------------------- */
+static bool parse_args(int argc, char** argv, Options& opt);
+static bool make_context(EGLDisplay& display, EGLContext& context);
+static int check(Options const& opt);
+
+/*                                                      function definitions
+----------------------------------------------------------------------------- */
+/*  _________________________________________________________________________ */
+/*! main
+
+@param argc, argv
+Options, see the file header.
+
+@return int
+0 if every frame read back matched and OpenGL reported no error, 1
+otherwise.
+*/
+int main(int argc, char** argv)
+{
+	Options opt;
+	if (!parse_args(argc, argv, opt))
+	{
+		return EXIT_FAILURE;
+	}
+
+	EGLDisplay display = EGL_NO_DISPLAY;
+	EGLContext context = EGL_NO_CONTEXT;
+	if (!make_context(display, context))
+	{
+		return EXIT_FAILURE;
+	}
+	std::cout << glGetString(GL_RENDERER) << ", " << glGetString(GL_VERSION) << std::endl;
+
+	GLPbo::init_rasterizer(opt.width, opt.height);
+	int result = check(opt);
+	GLPbo::cleanup_rasterizer();
+
+	eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroyContext(display, context);
+	eglTerminate(display);
+	return result;
+}
+
+/*  _________________________________________________________________________ */
+/*! check
+
+@param Options const&
+opt: command line options.
+
+@return int
+EXIT_SUCCESS if every frame read back matched and OpenGL reported no
+error, EXIT_FAILURE otherwise. Called with a current context and the
+rasterizer initialized.
+*/
+static int check(Options const& opt)
+{
+	if (!Scene::LoadScene(opt.scene))
+	{
+		return EXIT_FAILURE;
+	}
+	size_t triangles = 0;
+	for (GLPbo::Model const& model : Scene::models)
+	{
+		triangles += model.triangle_cnt();
+	}
+	if (triangles == 0)
+	{
+		std::cout << opt.scene << " has no triangles to check" << std::endl;
+		return EXIT_FAILURE;
+	}
+	Scene::current_draw_mode = Scene::DrawMode::SmoothShaded;
+	Scene::ToggleRotate();
+
+	// the ring and the targets release their GL objects before the context goes
+	PboRenderTarget pbo(opt.width, opt.height);
+	HostRenderTarget host(opt.width, opt.height), full(opt.width, opt.height);
+	std::vector<GLPbo::Color> back(static_cast<size_t>(opt.width) * opt.height);
+	size_t const bytes = back.size() * sizeof(GLPbo::Color);
+
+	int const check_frames = 40;
+	int mismatches = 0;
+	for (int f = 0; f < check_frames; ++f)
+	{
+		Scene::Update(1.0 / 60);
+		if (f % 7 == 3)
+		{
+			Scene::NextModel();
+			Scene::current_draw_mode = Scene::DrawMode::SmoothShaded;
+		}
+		if (f % 5 == 4)
+		{
+			Scene::NextDrawMode();
+		}
+		if (f == check_frames / 2)
+		{
+			GLPbo::set_clear_color(10, 20, 30);
+		}
+
+		GLPbo::render_scene(pbo);
+		GLPbo::render_scene(host);
+		GLPbo::dirty_tiles = false;
+		GLPbo::render_scene(full);
+		GLPbo::dirty_tiles = true;
+
+		glGetTextureImage(pbo.GetTexture(), 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(bytes), back.data());
+		bool pbo_differs = std::memcmp(back.data(), full.GetPixels(), bytes) != 0;
+		bool host_differs = std::memcmp(host.GetPixels(), full.GetPixels(), bytes) != 0;
+		if (pbo_differs || host_differs)
+		{
+			std::cout << "frame " << f << " differs:" << (pbo_differs ? " pbo" : "")
+				<< (host_differs ? " host" : "") << std::endl;
+			++mismatches;
+		}
+	}
+	GLenum error = glGetError();
+	std::cout << mismatches << " of " << check_frames << " frames differ, GL error 0x" << std::hex
+		<< error << std::dec << std::endl;
+
+	unsigned long long frames_before = pbo.GetFrameCount(), waits_before = pbo.GetWaitCount();
+	unsigned long long upload_before = pbo.GetUploadBytes();
+	double wait_before = pbo.GetWaitSeconds();
+	auto start = std::chrono::steady_clock::now();
+	for (int f = 0; f < opt.frames; ++f)
+	{
+		Scene::Update(1.0 / 60);
+		GLPbo::render_scene(pbo);
+	}
+	glFinish();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << pbo.GetFrameCount() - frames_before << " frames streamed through "
+		<< PboRenderTarget::ring_size << " pbos, " << pbo.GetWaitCount() - waits_before
+		<< " waited on a fence for " << (pbo.GetWaitSeconds() - wait_before) * 1e3 << " ms in total, "
+		<< ms / opt.frames << " ms/frame, "
+		<< (pbo.GetUploadBytes() - upload_before) / opt.frames / 1024 << " KiB uploaded per frame" << std::endl;
+
+	return mismatches == 0 && error == GL_NO_ERROR ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*  _________________________________________________________________________ */
+/*! make_context
+
+@param EGLDisplay&
+display: set to the surfaceless display.
+
+@param EGLContext&
+context: set to an OpenGL 4.5 core context, current without a surface.
+
+@return bool
+False, after printing why, if there is no such context.
+*/
+static bool make_context(EGLDisplay& display, EGLContext& context)
+{
+	auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+		eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (!get_platform_display)
+	{
+		std::cout << "EGL has no eglGetPlatformDisplayEXT" << std::endl;
+		return false;
+	}
+	display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	EGLint major, minor;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor) || !eglBindAPI(EGL_OPENGL_API))
+	{
+		std::cout << "no surfaceless EGL display, error 0x" << std::hex << eglGetError() << std::dec << std::endl;
+		return false;
+	}
+
+	EGLint const config_attribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+	EGLConfig config = nullptr;
+	EGLint config_cnt = 0;
+	eglChooseConfig(display, config_attribs, &config, 1, &config_cnt);
+	EGLint const context_attribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 5,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE };
+	context = eglCreateContext(display, config_cnt ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attribs);
+	if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+	{
+		std::cout << "no OpenGL 4.5 core context, EGL error 0x" << std::hex << eglGetError() << std::dec << std::endl;
+		eglTerminate(display);
+		return false;
+	}
+	return true;
+}
+
+/*  _________________________________________________________________________ */
+/*! parse_args
+
+@param argc, argv
+Command line.
+
+@param Options&
+opt: filled with the options given, the others keep their defaults.
+
+@return bool
+False, after printing why, if the command line is invalid.
+*/
+static bool parse_args(int argc, char** argv, Options& opt)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		// options that take values check there are enough left
+		auto values = [&](int count) { return i + count < argc; };
+
+		if (arg == "-frames" && values(1))
+		{
+			opt.frames = std::atoi(argv[++i]);
+		}
+		else if (arg == "-size" && values(2))
+		{
+			opt.width = std::atoi(argv[++i]);
+			opt.height = std::atoi(argv[++i]);
+		}
+		else if (arg == "-blocks")
+		{
+			GLPbo::block_layout = true;
+		}
+		else if (arg[0] != '-')
+		{
+			opt.scene = arg;
+		}
+		else
+		{
+			std::cout << "unknown or incomplete option " << arg << std::endl;
+			return false;
+		}
+	}
+
+	if (opt.frames < 1 || opt.width < 1 || opt.height < 1)
+	{
+		std::cout << "frames and size must be positive" << std::endl;
+		return false;
+	}
+	return true;
+}
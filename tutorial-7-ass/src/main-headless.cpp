@@ -0,0 +1,344 @@
+/*!
+@file    main-headless.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file renders frames of a .scn scene with the graphics pipe emulator
+into a HostRenderTarget, without a window or an OpenGL context, and writes
+the result to PPM or PNG files. It is meant for profiling the rasterizer and
+for regression testing its output on machines without a GPU:
+
+  tutorial-7-headless [options] [scene.scn]
+
+  -frames N     frames to render, default 100
+  -size W H     render target size, default 1800 1800 like the window
+  -model I      index of the model in the scene, default 0
+  -mode M       0 wireframe, 1 colored wireframe, 2 flat, 3 smooth (default),
+                4 normals, 5 textured
+  -texture PATH 256 x 256 .tex image for mode 5, default
+                ../images/duck-rgba-256.tex
+  -filter F     texture filter, 0 nearest, 1 bilinear, 2 trilinear (default)
+  -rotate       rotate the model by 1/60 s worth of time every frame
+  -tiled        GLPbo::tiled
+  -fixed        GLPbo::fixed_point
+  -depth        GLPbo::depth_test
+  -blocks       GLPbo::block_layout
+  -full         clear GLPbo::dirty_tiles, every frame clears and presents
+                every pixel
+  -slowclear    clear GLPbo::fast_clear, clears fill the color buffer
+                right away
+  -nocull       clear GLPbo::backface_culling
+  -noclusters   clear GLPbo::cluster_culling, every meshlet goes through
+                the vertex stage
+  -nocache      clear Scene::mesh_cache, models are parsed from their OBJ
+                files
+  -dpml         clear Scene::parallel_obj, OBJ files are parsed by
+                DPML::parse_obj_mesh(), in builds with DPML only
+  -compare      parse every model of the scene with both ObjParser and
+                DPML::parse_obj_mesh() and print how they differ instead of
+                rendering, in builds with DPML only
+  -noopt        clear Scene::optimize_meshes, models keep the triangle and
+                vertex order of their OBJ files
+  -out PATH     where the last frame is written, .png or .ppm by extension,
+                default headless.ppm
+  -all          write every frame, PATH gets the frame number appended
+
+Frame times, the average cache miss ratio and meshlets of the model (see
+meshopt.h) and how long the scene took to load are printed when done. Every
+option is deterministic, so two runs with the same options produce the
+same images.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include <glpbo.h>
+#include <meshopt.h>
+#include <rendertarget.h>
+#include <scene.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/*                                                         type declarations
+----------------------------------------------------------------------------- */
+/*!
+ * @brief ___Options___
+ * *********************
+ * Command line options, see the file header.
+*/
+struct Options
+{
+	std::string	scene = "../scenes/ass-1.scn";
+	int			frames = 100;
+	GLsizei		width = 1800, height = 1800;
+	unsigned	model = 0;
+	int			mode = static_cast<int>(Scene::DrawMode::SmoothShaded);
+	std::string	texture = "../images/duck-rgba-256.tex";
+	int			filter = static_cast<int>(GLPbo::Texture::Filter::Trilinear);
+	bool		rotate = false;
+	std::string	out = "headless.ppm";
+	bool		all = false;
+	bool		compare = false;
+};
+
+/*                                                      function declarations
+----------------------------------------------------------------------------- */
+static bool parse_args(int argc, char** argv, Options& opt);
+static bool write_image(std::string const& path, HostRenderTarget const& target);
+static std::string frame_path(std::string const& path, int frame);
+
+/*                                                      function definitions
+----------------------------------------------------------------------------- */
+/*  _________________________________________________________________________ */
+/*! main
+
+@param argc, argv
+Options, see the file header.
+
+@return int
+0 if every frame was rendered and written, or with -compare if every
+model matched, 1 otherwise.
+*/
+int main(int argc, char** argv)
+{
+	Options opt;
+	if (!parse_args(argc, argv, opt))
+	{
+		return EXIT_FAILURE;
+	}
+
+	GLPbo::init_rasterizer(opt.width, opt.height);
+	if (opt.compare)
+	{
+		bool match = Scene::CompareParsers(opt.scene);
+		GLPbo::cleanup_rasterizer();
+		return match ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	auto load_start = std::chrono::steady_clock::now();
+	if (!Scene::LoadScene(opt.scene) || opt.model >= Scene::models.size())
+	{
+		std::cout << "no model " << opt.model << " in " << opt.scene << std::endl;
+		return EXIT_FAILURE;
+	}
+	double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count();
+	if (opt.mode == static_cast<int>(Scene::DrawMode::Textured) && !Scene::LoadTexture(opt.texture))
+	{
+		return EXIT_FAILURE;
+	}
+	Scene::texture_filter = static_cast<GLPbo::Texture::Filter>(opt.filter);
+	Scene::current_model = opt.model;
+	Scene::current_draw_mode = static_cast<Scene::DrawMode>(opt.mode);
+	Scene::rotate = opt.rotate;
+
+	HostRenderTarget target(opt.width, opt.height);
+	double total_ms = 0.0, best_ms = 0.0;
+	for (int frame = 0; frame < opt.frames; ++frame)
+	{
+		auto start = std::chrono::steady_clock::now();
+		GLPbo::render_scene(target);
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		total_ms += ms;
+		best_ms = frame == 0 ? ms : std::min(best_ms, ms);
+
+		if ((opt.all || frame == opt.frames - 1) &&
+			!write_image(opt.all ? frame_path(opt.out, frame) : opt.out, target))
+		{
+			return EXIT_FAILURE;
+		}
+
+		// fixed time step keeps the images independent of how fast we render
+		Scene::Update(1.0 / 60.0);
+	}
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< opt.frames << " frames of " << Scene::models[opt.model].triangle_cnt() << " triangles (ACMR "
+		<< MeshOpt::ACMR(Scene::models[opt.model]) << ", " << Scene::models[opt.model].meshlets.size()
+		<< " meshlets) at " << opt.width << "x" << opt.height << ": "
+		<< total_ms / std::max(opt.frames, 1) << " ms/frame average, "
+		<< best_ms << " ms/frame best" << std::endl;
+	std::cout << Scene::models.size() << " models loaded in " << load_ms << " ms" << std::endl;
+
+	GLPbo::cleanup_rasterizer();
+	return EXIT_SUCCESS;
+}
+
+/*  _________________________________________________________________________ */
+/*! parse_args
+
+@param argc, argv
+Command line.
+
+@param Options&
+opt: filled with the options given, the others keep their defaults.
+
+@return bool
+False, after printing why, if the command line is invalid.
+*/
+static bool parse_args(int argc, char** argv, Options& opt)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		// options that take values check there are enough left
+		auto values = [&](int count) { return i + count < argc; };
+
+		if (arg == "-frames" && values(1))
+		{
+			opt.frames = std::atoi(argv[++i]);
+		}
+		else if (arg == "-size" && values(2))
+		{
+			opt.width = std::atoi(argv[++i]);
+			opt.height = std::atoi(argv[++i]);
+		}
+		else if (arg == "-model" && values(1))
+		{
+			opt.model = static_cast<unsigned>(std::atoi(argv[++i]));
+		}
+		else if (arg == "-mode" && values(1))
+		{
+			opt.mode = std::atoi(argv[++i]);
+		}
+		else if (arg == "-texture" && values(1))
+		{
+			opt.texture = argv[++i];
+		}
+		else if (arg == "-filter" && values(1))
+		{
+			opt.filter = std::atoi(argv[++i]);
+		}
+		else if (arg == "-out" && values(1))
+		{
+			opt.out = argv[++i];
+		}
+		else if (arg == "-rotate")
+		{
+			opt.rotate = true;
+		}
+		else if (arg == "-tiled")
+		{
+			GLPbo::tiled = true;
+		}
+		else if (arg == "-fixed")
+		{
+			GLPbo::fixed_point = true;
+		}
+		else if (arg == "-depth")
+		{
+			GLPbo::depth_test = true;
+		}
+		else if (arg == "-blocks")
+		{
+			GLPbo::block_layout = true;
+		}
+		else if (arg == "-full")
+		{
+			GLPbo::dirty_tiles = false;
+		}
+		else if (arg == "-slowclear")
+		{
+			GLPbo::fast_clear = false;
+		}
+		else if (arg == "-nocull")
+		{
+			GLPbo::backface_culling = false;
+		}
+		else if (arg == "-noclusters")
+		{
+			GLPbo::cluster_culling = false;
+		}
+		else if (arg == "-nocache")
+		{
+			Scene::mesh_cache = false;
+		}
+		else if (arg == "-dpml")
+		{
+			Scene::parallel_obj = false;
+		}
+		else if (arg == "-compare")
+		{
+			opt.compare = true;
+		}
+		else if (arg == "-noopt")
+		{
+			Scene::optimize_meshes = false;
+		}
+		else if (arg == "-all")
+		{
+			opt.all = true;
+		}
+		else if (arg[0] != '-')
+		{
+			opt.scene = arg;
+		}
+		else
+		{
+			std::cout << "unknown or incomplete option " << arg << std::endl;
+			return false;
+		}
+	}
+
+	if (opt.frames < 1 || opt.width < 1 || opt.height < 1 || opt.mode < 0 ||
+		opt.mode > static_cast<int>(Scene::DrawMode::Textured) ||
+		opt.filter < 0 || opt.filter > static_cast<int>(GLPbo::Texture::Filter::Trilinear))
+	{
+		std::cout << "frames and size must be positive, mode in [0, 5], filter in [0, 2]" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*  _________________________________________________________________________ */
+/*! write_image
+
+@param std::string const&
+path: file to write, PNG if it ends with .png, PPM otherwise.
+
+@param HostRenderTarget const&
+target: image to write.
+
+@return bool
+False, after printing why, if the file could not be written.
+*/
+static bool write_image(std::string const& path, HostRenderTarget const& target)
+{
+	bool png = path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0;
+	bool written = png ?
+		WritePNG(path, target.GetPixels(), target.GetWidth(), target.GetHeight()) :
+		WritePPM(path, target.GetPixels(), target.GetWidth(), target.GetHeight());
+	if (!written)
+	{
+		std::cout << "could not write " << path << std::endl;
+	}
+	return written;
+}
+
+/*  _________________________________________________________________________ */
+/*! frame_path
+
+@param std::string const&
+path: -out option.
+
+@param int
+frame: frame number.
+
+@return std::string
+path with the zero padded frame number inserted before the extension.
+*/
+static std::string frame_path(std::string const& path, int frame)
+{
+	size_t dot = path.find_last_of('.');
+	size_t slash = path.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+	{
+		dot = path.size();
+	}
+	std::ostringstream sstr;
+	sstr << path.substr(0, dot) << "_" << std::setw(4) << std::setfill('0') << frame << path.substr(dot);
+	return sstr.str();
+}
@@ -74,7 +74,8 @@ static void update() {
   double delta_time = GLHelper::update_time(1.0);
   // write window title with current fps ...
   std::stringstream sstr;
-  sstr << std::fixed << std::setprecision(2) << GLHelper::title << ": " << GLHelper::fps;
+  sstr << std::fixed << std::setprecision(2) << GLHelper::title << ": " << GLHelper::fps
+       << " | fence wait " << GLPbo::fence_wait_ms() << " ms/frame";
   glfwSetWindowTitle(GLHelper::ptr_window, sstr.str().c_str());
 
   // Part 3
@@ -0,0 +1,359 @@
+/* !
+@file    meshcache.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the functions declared in meshcache.h
+that read and write the binary mesh cache.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "meshcache.h"
+#include "mappedfile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace MeshCache
+{
+	static char const magic[8] = { 'G', 'L', 'P', 'B', 'O', 'M', 'S', 'H' };
+
+	// rounds bytes up to a multiple of alignment
+	static uint64_t Align(uint64_t bytes)
+	{
+		return (bytes + alignment - 1) / alignment * alignment;
+	}
+
+	// bytes of an array of a cache with the given header
+	static uint64_t ArrayBytes(Header const& header, uint32_t array)
+	{
+		return array == Indices ?
+			static_cast<uint64_t>(header.index_cnt) * header.index_size :
+			static_cast<uint64_t>(header.padded_cnt) * sizeof(float);
+	}
+
+	/*!
+	 * @brief ___MeshCache::Hash___
+	 * *******************************
+	 * 64-bit FNV-1a hash of size bytes.
+	*/
+	static uint64_t Hash(unsigned char const* bytes, size_t size)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	/*!
+	 * @brief ___MeshCache::HashFile___
+	 * *******************************
+	 * Hash of the bytes of a file, false if it could not be mapped.
+	*/
+	static bool HashFile(std::string const& path, uint64_t& hash)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+		hash = Hash(file.GetData(), file.GetSize());
+		return true;
+	}
+
+	/*!
+	 * @brief ___MeshCache::Valid___
+	 * *******************************
+	 * True if a mapped file is a complete cache this build can read: every
+	 * array lies within the file, on an aligned offset, and every index
+	 * addresses one of its vertices.
+	*/
+	static bool Valid(MappedFile const& file)
+	{
+		if (file.GetSize() < sizeof(Header))
+		{
+			return false;
+		}
+		Header header;
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+			header.header_size != sizeof(Header) || header.vertex_cnt > header.padded_cnt ||
+			header.padded_cnt % padding != 0 || header.index_cnt % 3 != 0)
+		{
+			return false;
+		}
+		// 16-bit indices only for models that fit them, as Model::set_triangles() does
+		bool narrow = header.vertex_cnt <= std::numeric_limits<unsigned short>::max() + 1ull;
+		if (header.index_size != (narrow ? sizeof(unsigned short) : sizeof(GLuint)))
+		{
+			return false;
+		}
+		for (uint32_t a = 0; a < ArrayCount; ++a)
+		{
+			if (header.offset[a] % alignment != 0 || header.offset[a] > file.GetSize() ||
+				ArrayBytes(header, a) > file.GetSize() - header.offset[a])
+			{
+				return false;
+			}
+		}
+		unsigned char const* indices = file.GetData() + header.offset[Indices];
+		auto in_range = [&](auto const* index)
+		{
+			return std::all_of(index, index + header.index_cnt, [&](GLuint i) { return i < header.vertex_cnt; });
+		};
+		return narrow ?
+			in_range(reinterpret_cast<unsigned short const*>(indices)) :
+			in_range(reinterpret_cast<GLuint const*>(indices));
+	}
+
+	/*!
+	 * @brief ___MeshCache::Fresh___
+	 * *******************************
+	 * True if a cache was built from the source as it is now. Sources that
+	 * were only touched keep their cache, as long as their bytes hash the
+	 * same, and so do sources that are gone.
+	*/
+	static bool Fresh(Header const& header, std::string const& source, bool& touched)
+	{
+		touched = false;
+		uint64_t bytes;
+		int64_t mtime;
+		if (!MappedFile::Stat(source, bytes, mtime))
+		{
+			return true;
+		}
+		if (bytes != header.source_size)
+		{
+			return false;
+		}
+		if (mtime == header.source_mtime)
+		{
+			return true;
+		}
+		uint64_t hash;
+		touched = HashFile(source, hash) && hash == header.source_hash;
+		return touched;
+	}
+
+	/*!
+	 * @brief ___MeshCache::Read___
+	 * *******************************
+	 * Copies the arrays of a valid cache into a model, the indices into tri
+	 * or tri32 by their size. Only pm gets the positions, the vertex stage
+	 * buffers are copied from it on the first transform_vertices() like
+	 * those of any other model.
+	*/
+	static void Read(MappedFile const& file, GLPbo::Model& model)
+	{
+		Header header;
+		std::memcpy(&header, file.GetData(), sizeof(Header));
+		auto floats = [&](uint32_t array)
+		{
+			return reinterpret_cast<float const*>(file.GetData() + header.offset[array]);
+		};
+		float const* x = floats(PositionX), * y = floats(PositionY), * z = floats(PositionZ);
+		float const* nx = floats(NormalX), * ny = floats(NormalY), * nz = floats(NormalZ);
+		float const* u = floats(TexcoordU), * v = floats(TexcoordV);
+
+		size_t n = header.vertex_cnt;
+		model.pm.resize(n);
+		model.nml.resize(n);
+		model.tex.resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			model.pm[i] = { x[i], y[i], z[i] };
+			model.nml[i] = { nx[i], ny[i], nz[i] };
+			model.tex[i] = { u[i], v[i] };
+		}
+		unsigned char const* indices = file.GetData() + header.offset[Indices];
+		if (header.index_size == sizeof(GLuint))
+		{
+			model.tri32.resize(header.index_cnt);
+			std::memcpy(model.tri32.data(), indices, model.tri32.size() * sizeof(GLuint));
+		}
+		else
+		{
+			model.tri.resize(header.index_cnt);
+			std::memcpy(model.tri.data(), indices, model.tri.size() * sizeof(unsigned short));
+		}
+	}
+
+	/*!
+	 * @brief ___MeshCache::CachePath___
+	 * *******************************
+	 * Path of the cache of a source mesh.
+	*/
+	std::string CachePath(std::string const& source)
+	{
+		return source + ".cache";
+	}
+
+	/*!
+	 * @brief ___MeshCache::Load___
+	 * ****************************************************************************************************
+	 * Loads a model from the cache of a source mesh. If there is no usable
+	 * cache, builds the model from the source and writes its cache.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the source mesh.
+	 * @param model
+	 * : Empty model to load into.
+	 * @param build
+	 * : Builds a model from the source, returns false if it could not.
+	 * @param build_flags
+	 * : What build() does differently from one run to the next, such as
+	 * which options it post-processes with. A cache written with other
+	 * flags is rebuilt.
+	 * @return bool
+	 * : False if there was no usable cache and build() failed. A cache that
+	 * could not be written is reported, but the built model is kept.
+	 * ****************************************************************************************************
+	*/
+	bool Load(std::string const& source, GLPbo::Model& model, bool (*build)(std::string const&, GLPbo::Model&),
+		uint32_t build_flags)
+	{
+		bool loaded = false, touched = false;
+		{
+			MappedFile file;
+			if (file.Open(CachePath(source)) && Valid(file))
+			{
+				Header header;
+				std::memcpy(&header, file.GetData(), sizeof(Header));
+				loaded = header.build_flags == build_flags && Fresh(header, source, touched);
+				if (loaded)
+				{
+					Read(file, model);
+				}
+			}
+		}
+		// the cache is unmapped before it is rewritten
+		if (loaded)
+		{
+			// a touched source gets its modification time recorded, so it is
+			// not hashed again on every load
+			if (touched)
+			{
+				Write(source, model, build_flags);
+			}
+			return true;
+		}
+
+		if (!build(source, model))
+		{
+			return false;
+		}
+		Write(source, model, build_flags);
+		return true;
+	}
+
+	/*!
+	 * @brief ___MeshCache::Write___
+	 * ****************************************************************************************************
+	 * Writes a model to the cache of a source mesh.
+	 * ****************************************************************************************************
+	 * @param source
+	 * : Path of the source mesh the model was built from.
+	 * @param model
+	 * : Model to write, its pm, nml, tex and tri or tri32.
+	 * @param build_flags
+	 * : Flags the model was built with, see Load().
+	 * @return bool
+	 * : False, after printing why, if the source could not be read or the
+	 * cache could not be written.
+	 * ****************************************************************************************************
+	*/
+	bool Write(std::string const& source, GLPbo::Model const& model, uint32_t build_flags)
+	{
+		std::string path = CachePath(source);
+		size_t n = model.pm.size();
+		if (model.nml.size() != n || model.tex.size() != n)
+		{
+			std::cout << "cache " << path << " not written, the model needs a normal and texture coordinates per vertex" << std::endl;
+			return false;
+		}
+
+		Header header{};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.header_size = sizeof(Header);
+		header.build_flags = build_flags;
+		if (!MappedFile::Stat(source, header.source_size, header.source_mtime) || !HashFile(source, header.source_hash))
+		{
+			std::cout << "cache " << path << " not written, " << source << " could not be read" << std::endl;
+			return false;
+		}
+		header.vertex_cnt = static_cast<uint32_t>(n);
+		header.padded_cnt = static_cast<uint32_t>((n + padding - 1) / padding * padding);
+		bool wide = !model.tri32.empty();
+		header.index_cnt = static_cast<uint32_t>(wide ? model.tri32.size() : model.tri.size());
+		header.index_size = wide ? sizeof(GLuint) : sizeof(unsigned short);
+
+		glm::vec3 lo(n ? model.pm[0] : glm::vec3(0.f)), hi(lo);
+		for (glm::vec3 const& p : model.pm)
+		{
+			lo = glm::min(lo, p);
+			hi = glm::max(hi, p);
+		}
+		std::memcpy(header.bounds_min, &lo.x, sizeof(header.bounds_min));
+		std::memcpy(header.bounds_max, &hi.x, sizeof(header.bounds_max));
+
+		uint64_t end = Align(sizeof(Header));
+		for (uint32_t a = 0; a < ArrayCount; ++a)
+		{
+			header.offset[a] = end;
+			end = Align(end + ArrayBytes(header, a));
+		}
+
+		// the whole file is put together in memory and written in one go
+		std::vector<unsigned char> bytes(static_cast<size_t>(end), 0);
+		std::memcpy(bytes.data(), &header, sizeof(Header));
+		auto floats = [&](uint32_t array)
+		{
+			return reinterpret_cast<float*>(bytes.data() + header.offset[array]);
+		};
+		for (size_t i = 0; i < n; ++i)
+		{
+			floats(PositionX)[i] = model.pm[i].x;
+			floats(PositionY)[i] = model.pm[i].y;
+			floats(PositionZ)[i] = model.pm[i].z;
+			floats(NormalX)[i] = model.nml[i].x;
+			floats(NormalY)[i] = model.nml[i].y;
+			floats(NormalZ)[i] = model.nml[i].z;
+			floats(TexcoordU)[i] = model.tex[i].x;
+			floats(TexcoordV)[i] = model.tex[i].y;
+		}
+		if (header.index_cnt > 0)
+		{
+			void const* indices = wide ? static_cast<void const*>(model.tri32.data()) : model.tri.data();
+			std::memcpy(bytes.data() + header.offset[Indices], indices, static_cast<size_t>(ArrayBytes(header, Indices)));
+		}
+
+		// written under another name first, so a cache is never seen half
+		// written
+		std::string temp = path + ".tmp";
+		{
+			std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file || !file.write(reinterpret_cast<char const*>(bytes.data()), bytes.size()))
+			{
+				std::cout << "cache " << path << " could not be written" << std::endl;
+				return false;
+			}
+		}
+		std::remove(path.c_str());
+		if (std::rename(temp.c_str(), path.c_str()) != 0)
+		{
+			std::cout << "cache " << path << " could not be written" << std::endl;
+			std::remove(temp.c_str());
+			return false;
+		}
+		return true;
+	}
+}
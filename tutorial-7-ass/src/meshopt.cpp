@@ -0,0 +1,400 @@
+/* !
+@file    meshopt.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the functions declared in meshopt.h
+that reorder models for vertex cache and fetch locality and split them
+into meshlets.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "meshopt.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace MeshOpt
+{
+	/*!
+	 * @brief ___MeshOpt::Misses___
+	 * *******************************
+	 * Vertices a FIFO cache of cache_size entries misses when count
+	 * indices are read in order.
+	*/
+	template <typename Index>
+	static size_t Misses(Index const* tri, size_t count, size_t vertex_cnt)
+	{
+		// a vertex is cached while fewer than cache_size misses happened
+		// since its own, which is what a FIFO evicts by
+		std::vector<size_t> missed_at(vertex_cnt, 0);
+		size_t misses = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			size_t& at = missed_at[tri[i]];
+			if (at == 0 || misses + 1 - at > cache_size)
+			{
+				at = ++misses;
+			}
+		}
+		return misses;
+	}
+
+	/*!
+	 * @brief ___MeshOpt::Tipsify___
+	 * *******************************
+	 * Reorders triangles for a vertex cache of cache_size entries, in time
+	 * linear in the number of triangles. Each step emits every triangle
+	 * left around the fanning vertex, then picks the next one among the
+	 * vertices just emitted: the one that entered the cache earliest of
+	 * those that will still be cached once their remaining triangles are
+	 * emitted. When there is none, the most recently emitted vertex with
+	 * triangles left is used, failing that the next such vertex by index.
+	*/
+	template <typename Index>
+	static void Tipsify(std::vector<Index>& tri, size_t vertex_cnt)
+	{
+		size_t faces = tri.size() / 3;
+
+		// triangles around each vertex, in compressed row form
+		std::vector<uint32_t> live(vertex_cnt, 0), first(vertex_cnt + 1, 0), around(faces * 3);
+		for (Index v : tri)
+		{
+			++live[v];
+		}
+		for (size_t v = 0; v < vertex_cnt; ++v)
+		{
+			first[v + 1] = first[v] + live[v];
+		}
+		{
+			std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+			for (size_t i = 0; i < tri.size(); ++i)
+			{
+				around[fill[tri[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// cache_time[v] is the time stamp v entered the simulated cache,
+		// which holds the vertices stamped within cache_size of now
+		int64_t const k = static_cast<int64_t>(cache_size);
+		std::vector<int64_t> cache_time(vertex_cnt, 0);
+		int64_t time = k + 1;
+		std::vector<bool> emitted(faces, false);
+		std::vector<uint32_t> dead_end, candidates;
+		dead_end.reserve(tri.size());
+		std::vector<Index> out;
+		out.reserve(tri.size());
+		size_t cursor = 0;
+
+		// most recently emitted vertex with triangles left, or the next one
+		// by index, vertex_cnt when every triangle is emitted
+		auto skip_dead_end = [&]() -> size_t
+		{
+			while (!dead_end.empty())
+			{
+				uint32_t d = dead_end.back();
+				dead_end.pop_back();
+				if (live[d] > 0)
+				{
+					return d;
+				}
+			}
+			while (cursor < vertex_cnt && live[cursor] == 0)
+			{
+				++cursor;
+			}
+			return cursor;
+		};
+
+		for (size_t fan = skip_dead_end(); fan < vertex_cnt; )
+		{
+			candidates.clear();
+			for (uint32_t a = first[fan]; a < first[fan + 1]; ++a)
+			{
+				uint32_t t = around[a];
+				if (emitted[t])
+				{
+					continue;
+				}
+				emitted[t] = true;
+				for (int c = 0; c < 3; ++c)
+				{
+					Index v = tri[t * 3 + c];
+					out.push_back(v);
+					dead_end.push_back(v);
+					candidates.push_back(v);
+					--live[v];
+					if (time - cache_time[v] > k)
+					{
+						cache_time[v] = time++;
+					}
+				}
+			}
+
+			// the candidate that entered the cache earliest, of those still
+			// cached after their remaining triangles are emitted
+			size_t next = vertex_cnt;
+			int64_t best = -1;
+			for (uint32_t v : candidates)
+			{
+				if (live[v] == 0)
+				{
+					continue;
+				}
+				int64_t priority = 0;
+				if (time - cache_time[v] + 2 * static_cast<int64_t>(live[v]) <= k)
+				{
+					priority = time - cache_time[v];
+				}
+				if (priority > best)
+				{
+					best = priority;
+					next = v;
+				}
+			}
+			fan = next < vertex_cnt ? next : skip_dead_end();
+		}
+		tri.swap(out);
+	}
+
+	/*!
+	 * @brief ___MeshOpt::ReorderVertices___
+	 * *******************************
+	 * Renumbers the vertices of a model in the order its triangles first
+	 * use them, unused vertices last, and moves their attributes along.
+	*/
+	template <typename Index>
+	static void ReorderVertices(GLPbo::Model& model, std::vector<Index>& tri)
+	{
+		size_t n = model.pm.size();
+		uint32_t const unused = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> remap(n, unused);
+		uint32_t next = 0;
+		for (Index& v : tri)
+		{
+			if (remap[v] == unused)
+			{
+				remap[v] = next++;
+			}
+			v = static_cast<Index>(remap[v]);
+		}
+		for (size_t v = 0; v < n; ++v)
+		{
+			if (remap[v] == unused)
+			{
+				remap[v] = next++;
+			}
+		}
+
+		// attributes that are missing or do not match pm are left alone
+		auto move = [&](auto& attribute)
+		{
+			if (attribute.size() != n)
+			{
+				return;
+			}
+			auto moved = attribute;
+			for (size_t v = 0; v < n; ++v)
+			{
+				moved[remap[v]] = attribute[v];
+			}
+			attribute.swap(moved);
+		};
+		move(model.pm);
+		move(model.nml);
+		move(model.tex);
+	}
+
+	/*!
+	 * @brief ___MeshOpt::ACMR___
+	 * ****************************************************************************************************
+	 * Average cache miss ratio of a model's triangles in their current
+	 * order, through a FIFO cache of cache_size vertices.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to measure, its tri or tri32.
+	 * @return float
+	 * : Cache misses per triangle, 0 for a model without triangles.
+	 * ****************************************************************************************************
+	*/
+	float ACMR(GLPbo::Model const& model)
+	{
+		size_t faces = model.triangle_cnt();
+		if (faces == 0)
+		{
+			return 0.f;
+		}
+		size_t misses = 0;
+		model.visit_triangles([&](auto const* tri)
+		{
+			misses = Misses(tri, faces * 3, model.pm.size());
+		});
+		return static_cast<float>(misses) / faces;
+	}
+
+	/*!
+	 * @brief ___MeshOpt::Optimize___
+	 * ****************************************************************************************************
+	 * Reorders a model's triangles with Tipsify, then its vertices in the
+	 * order the triangles first use them.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to reorder, its pm, nml, tex and tri or tri32.
+	 * @return Stats
+	 * : ACMR of the model before and after.
+	 * ****************************************************************************************************
+	*/
+	Stats Optimize(GLPbo::Model& model)
+	{
+		Stats stats;
+		stats.acmr_before = ACMR(model);
+		auto optimize = [&](auto& tri)
+		{
+			Tipsify(tri, model.pm.size());
+			ReorderVertices(model, tri);
+		};
+		if (model.tri32.empty())
+		{
+			optimize(model.tri);
+		}
+		else
+		{
+			optimize(model.tri32);
+		}
+		// the vertex stage buffers hold pm in its old order
+		model.px.clear();
+		model.py.clear();
+		model.pz.clear();
+		stats.acmr_after = ACMR(model);
+		return stats;
+	}
+
+	/*!
+	 * @brief ___MeshOpt::Bound___
+	 * *******************************
+	 * Bounding sphere and normal cone of count triangles from first.
+	*/
+	template <typename Index>
+	static GLPbo::Meshlet Bound(GLPbo::Model const& model, Index const* tri, size_t first, size_t count)
+	{
+		GLPbo::Meshlet m;
+		m.first_triangle = static_cast<GLuint>(first);
+		m.triangle_cnt = static_cast<GLuint>(count);
+
+		// the sphere is centered on the box around the positions used
+		Index const* begin = tri + first * 3;
+		Index const* end = begin + count * 3;
+		glm::vec3 lo(model.pm[*begin]), hi(lo);
+		GLuint v_lo = *begin, v_hi = *begin;
+		for (Index const* v = begin; v != end; ++v)
+		{
+			lo = glm::min(lo, model.pm[*v]);
+			hi = glm::max(hi, model.pm[*v]);
+			v_lo = std::min<GLuint>(v_lo, *v);
+			v_hi = std::max<GLuint>(v_hi, *v);
+		}
+		m.first_vertex = v_lo;
+		m.vertex_cnt = v_hi - v_lo + 1;
+		m.center = (lo + hi) * 0.5f;
+		for (Index const* v = begin; v != end; ++v)
+		{
+			m.radius = std::max(m.radius, glm::length(model.pm[*v] - m.center));
+		}
+
+		// the cone is around the mean normal, degenerate triangles are
+		// always culled as back faces and have no say in it
+		std::vector<glm::vec3> normals;
+		normals.reserve(count);
+		glm::vec3 sum(0.f);
+		for (Index const* t = begin; t != end; t += 3)
+		{
+			glm::vec3 n = glm::cross(model.pm[t[1]] - model.pm[t[0]], model.pm[t[2]] - model.pm[t[0]]);
+			float len = glm::length(n);
+			if (len > 0.f)
+			{
+				normals.push_back(n / len);
+				sum += normals.back();
+			}
+		}
+		float sum_len = glm::length(sum);
+		if (sum_len <= 0.f)
+		{
+			return m;
+		}
+		m.cone_axis = sum / sum_len;
+		float cone_cos = 1.f;
+		for (glm::vec3 const& n : normals)
+		{
+			cone_cos = std::min(cone_cos, glm::dot(n, m.cone_axis));
+		}
+		// widened a little against the rounding of the normals
+		float angle = std::acos(std::max(-1.f, std::min(1.f, cone_cos))) + cone_slack;
+		if (angle < 1.5707963f)
+		{
+			m.cone_cos = std::cos(angle);
+			m.cone_sin = std::sin(angle);
+		}
+		return m;
+	}
+
+	/*!
+	 * @brief ___MeshOpt::Split___
+	 * *******************************
+	 * Cuts consecutive triangles into meshlets of meshlet_min to
+	 * meshlet_max, ending one early once a triangle turns too far from the
+	 * mean normal of those before it.
+	*/
+	template <typename Index>
+	static void Split(GLPbo::Model& model, Index const* tri, size_t faces)
+	{
+		model.meshlets.clear();
+		float const turn_cos = std::cos(meshlet_turn);
+		size_t first = 0;
+		glm::vec3 sum(0.f);
+		for (size_t f = 0; f < faces; ++f)
+		{
+			Index const* t = tri + f * 3;
+			glm::vec3 n = glm::cross(model.pm[t[1]] - model.pm[t[0]], model.pm[t[2]] - model.pm[t[0]]);
+			float len = glm::length(n), sum_len = glm::length(sum);
+			size_t size = f - first;
+			bool turns = len > 0.f && sum_len > 0.f && glm::dot(n / len, sum / sum_len) < turn_cos;
+			if (size == meshlet_max || (size >= meshlet_min && turns))
+			{
+				model.meshlets.push_back(Bound(model, tri, first, size));
+				first = f;
+				sum = glm::vec3(0.f);
+			}
+			if (len > 0.f)
+			{
+				sum += n / len;
+			}
+		}
+		if (first < faces)
+		{
+			model.meshlets.push_back(Bound(model, tri, first, faces - first));
+		}
+	}
+
+	/*!
+	 * @brief ___MeshOpt::BuildMeshlets___
+	 * ****************************************************************************************************
+	 * Splits a model's triangles, in their current order, into meshlets of
+	 * meshlet_min to meshlet_max triangles and bounds each.
+	 * ****************************************************************************************************
+	 * @param model
+	 * : Model to split, its meshlets are replaced.
+	 * ****************************************************************************************************
+	*/
+	void BuildMeshlets(GLPbo::Model& model)
+	{
+		size_t faces = model.triangle_cnt();
+		model.visit_triangles([&](auto const* tri)
+		{
+			Split(model, tri, faces);
+		});
+	}
+}
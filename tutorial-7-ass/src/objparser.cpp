@@ -0,0 +1,598 @@
+/* !
+@file    objparser.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of ObjParser::Parse() declared in
+objparser.h and the chunk parsing and merging it is built on.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "objparser.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+namespace ObjParser
+{
+	constexpr size_t	min_chunk = 1 << 20;	/*!< smallest chunk worth a task, in bytes */
+	constexpr int32_t	absent = -1;			/*!< index of an attribute a corner does not have */
+
+	// what a line of an OBJ file holds
+	enum class Record
+	{
+		Other, Position, Texcoord, Normal, Face
+	};
+
+	// corner of a triangle, as 0-based indices into the file's records
+	struct Corner
+	{
+		int32_t p, t, n;
+	};
+
+	/*!
+	 * @brief ___ObjParser::Chunk___
+	 * *******************************
+	 * Whole lines of the file parsed by one task.
+	*/
+	struct Chunk
+	{
+		char const*			begin;
+		char const*			end;
+		uint32_t			counts[3]{};	/*!< v, vt and vn records, counted in the first pass */
+		uint32_t			bases[3]{};		/*!< v, vt and vn records of the chunks before */
+		std::vector<Corner>	corners;		/*!< 3 per triangle */
+		bool				failed{ false };
+	};
+
+	static bool Blank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	// end of the line starting at p
+	static char const* LineEnd(char const* p, char const* end)
+	{
+		char const* nl = static_cast<char const*>(std::memchr(p, '\n', end - p));
+		return nl ? nl : end;
+	}
+
+	/*!
+	 * @brief ___ObjParser::Tag___
+	 * *******************************
+	 * Record held by the line [p, end), p is moved past its tag.
+	*/
+	static Record Tag(char const*& p, char const* end)
+	{
+		while (p != end && Blank(*p))
+		{
+			++p;
+		}
+		auto tag = [&](char const* q, Record record)
+		{
+			if (q != end && !Blank(*q))
+			{
+				return Record::Other;
+			}
+			p = q;
+			return record;
+		};
+		if (end - p >= 1 && p[0] == 'f')
+		{
+			return tag(p + 1, Record::Face);
+		}
+		if (end - p >= 1 && p[0] == 'v')
+		{
+			if (end - p >= 2 && p[1] == 't')
+			{
+				return tag(p + 2, Record::Texcoord);
+			}
+			if (end - p >= 2 && p[1] == 'n')
+			{
+				return tag(p + 2, Record::Normal);
+			}
+			return tag(p + 1, Record::Position);
+		}
+		return Record::Other;
+	}
+
+	/*!
+	 * @brief ___ObjParser::SlowFloat___
+	 * *******************************
+	 * strtof() of the word at p, for what FastFloat() does not round
+	 * exactly. The word is copied, the file is not NUL-terminated.
+	*/
+	static bool SlowFloat(char const*& p, char const* end, float& out)
+	{
+		char buffer[64];
+		size_t length = 0;
+		while (p + length != end && !Blank(p[length]) && p[length] != '\n' && length + 1 < sizeof(buffer))
+		{
+			buffer[length] = p[length];
+			++length;
+		}
+		buffer[length] = '\0';
+		char* stop;
+		out = std::strtof(buffer, &stop);
+		if (stop == buffer)
+		{
+			return false;
+		}
+		p += stop - buffer;
+		return true;
+	}
+
+	/*!
+	 * @brief ___ObjParser::FastFloat___
+	 * *******************************
+	 * Reads the decimal number at p, rounded exactly as strtof() rounds it.
+	 * Numbers of up to 19 significant digits and powers of ten of up to 22
+	 * are one exact double operation away from their value, and rounding
+	 * that double to float is exact unless it lies halfway between two
+	 * floats. Anything else is left to SlowFloat().
+	*/
+	static bool FastFloat(char const*& p, char const* end, float& out)
+	{
+		static double const powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		char const* q = p;
+		bool negative = q != end && *q == '-';
+		if (q != end && (*q == '-' || *q == '+'))
+		{
+			++q;
+		}
+		uint64_t mantissa = 0;
+		int digits = 0, exponent = 0;
+		bool any = false, exact = true;
+		for (; q != end && *q >= '0' && *q <= '9'; ++q, any = true)
+		{
+			if (digits < 19)
+			{
+				mantissa = mantissa * 10 + (*q - '0');
+				digits += mantissa != 0;
+			}
+			else
+			{
+				++exponent;
+				exact &= *q == '0';
+			}
+		}
+		if (q != end && *q == '.')
+		{
+			for (++q; q != end && *q >= '0' && *q <= '9'; ++q, any = true)
+			{
+				if (digits < 19)
+				{
+					mantissa = mantissa * 10 + (*q - '0');
+					digits += mantissa != 0;
+					--exponent;
+				}
+				else
+				{
+					exact &= *q == '0';
+				}
+			}
+		}
+		if (!any)
+		{
+			// inf, nan or no number at all
+			return SlowFloat(p, end, out);
+		}
+		if (q != end && (*q == 'e' || *q == 'E'))
+		{
+			char const* e = q + 1;
+			bool minus = e != end && *e == '-';
+			if (e != end && (*e == '-' || *e == '+'))
+			{
+				++e;
+			}
+			if (e != end && *e >= '0' && *e <= '9')
+			{
+				int value = 0;
+				for (; e != end && *e >= '0' && *e <= '9'; ++e)
+				{
+					value = std::min(value * 10 + (*e - '0'), 100000);
+				}
+				exponent += minus ? -value : value;
+				q = e;
+			}
+		}
+
+		if (!exact || mantissa > (1ull << 53) || exponent < -22 || exponent > 22)
+		{
+			return SlowFloat(p, end, out);
+		}
+		double value = static_cast<double>(mantissa);
+		value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+		if (value != 0.0 && (value > FLT_MAX || value < FLT_MIN))
+		{
+			return SlowFloat(p, end, out);
+		}
+		float rounded = static_cast<float>(value);
+		if (static_cast<double>(rounded) != value)
+		{
+			// the sum of two neighbouring floats is exact in double
+			float other = std::nextafter(rounded, value > rounded ? FLT_MAX : 0.f);
+			if ((static_cast<double>(rounded) + other) * 0.5 == value)
+			{
+				return SlowFloat(p, end, out);
+			}
+		}
+		out = negative ? -rounded : rounded;
+		p = q;
+		return true;
+	}
+
+	// reads up to count numbers from [p, end), numbers that are not there are 0
+	static void Floats(char const* p, char const* end, float* out, int count)
+	{
+		std::fill(out, out + count, 0.f);
+		for (int i = 0; i < count; ++i)
+		{
+			while (p != end && Blank(*p))
+			{
+				++p;
+			}
+			if (p == end || !FastFloat(p, end, out[i]))
+			{
+				return;
+			}
+		}
+	}
+
+	/*!
+	 * @brief ___ObjParser::Index___
+	 * *******************************
+	 * Reads an index at p and resolves it to a 0-based index: positive
+	 * indices count from 1, negative ones back from the read records.
+	 * False if there is no index or it is out of [0, total).
+	*/
+	static bool Index(char const*& p, char const* end, uint32_t read, uint32_t total, int32_t& out)
+	{
+		bool negative = p != end && *p == '-';
+		if (p != end && (*p == '-' || *p == '+'))
+		{
+			++p;
+		}
+		int64_t value = 0;
+		char const* digits = p;
+		for (; p != end && *p >= '0' && *p <= '9'; ++p)
+		{
+			value = std::min<int64_t>(value * 10 + (*p - '0'), std::numeric_limits<int32_t>::max());
+		}
+		if (p == digits || value == 0)
+		{
+			return false;
+		}
+		int64_t index = negative ? static_cast<int64_t>(read) - value : value - 1;
+		out = static_cast<int32_t>(index);
+		return index >= 0 && index < total;
+	}
+
+	/*!
+	 * @brief ___ObjParser::Count___
+	 * *******************************
+	 * First pass over a chunk, counts its v, vt and vn records.
+	*/
+	static void Count(Chunk& chunk)
+	{
+		for (char const* line = chunk.begin; line != chunk.end;)
+		{
+			char const* end = LineEnd(line, chunk.end);
+			char const* p = line;
+			switch (Tag(p, end))
+			{
+			case Record::Position:	++chunk.counts[0]; break;
+			case Record::Texcoord:	++chunk.counts[1]; break;
+			case Record::Normal:	++chunk.counts[2]; break;
+			default:				break;
+			}
+			line = end == chunk.end ? end : end + 1;
+		}
+	}
+
+	/*!
+	 * @brief ___ObjParser::ParseChunk___
+	 * *******************************
+	 * Second pass over a chunk. Attributes are written to their place in
+	 * the file-wide arrays, and faces become triangles of file-wide
+	 * corners.
+	*/
+	static void ParseChunk(Chunk& chunk, uint32_t const totals[3],
+		glm::vec3* v, glm::vec2* vt, glm::vec3* vn)
+	{
+		uint32_t read[3] = { chunk.bases[0], chunk.bases[1], chunk.bases[2] };
+		for (char const* line = chunk.begin; line != chunk.end && !chunk.failed;)
+		{
+			char const* end = LineEnd(line, chunk.end);
+			char const* p = line;
+			switch (Tag(p, end))
+			{
+			case Record::Position:
+				Floats(p, end, &v[read[0]++].x, 3);
+				break;
+			case Record::Texcoord:
+				Floats(p, end, &vt[read[1]++].x, 2);
+				break;
+			case Record::Normal:
+				Floats(p, end, &vn[read[2]++].x, 3);
+				break;
+			case Record::Face:
+			{
+				Corner first{}, previous{};
+				for (int corner = 0; ; ++corner)
+				{
+					while (p != end && Blank(*p))
+					{
+						++p;
+					}
+					if (p == end || *p == '#')
+					{
+						break;
+					}
+					// p, p/t, p//n or p/t/n
+					Corner c{ absent, absent, absent };
+					chunk.failed = !Index(p, end, read[0], totals[0], c.p);
+					if (!chunk.failed && p != end && *p == '/')
+					{
+						++p;
+						if (p != end && *p != '/')
+						{
+							chunk.failed = !Index(p, end, read[1], totals[1], c.t);
+						}
+						if (!chunk.failed && p != end && *p == '/')
+						{
+							++p;
+							chunk.failed = !Index(p, end, read[2], totals[2], c.n);
+						}
+					}
+					if (chunk.failed)
+					{
+						break;
+					}
+					if (corner == 0)
+					{
+						first = c;
+					}
+					else if (corner >= 2)
+					{
+						chunk.corners.push_back(first);
+						chunk.corners.push_back(previous);
+						chunk.corners.push_back(c);
+					}
+					previous = c;
+				}
+				break;
+			}
+			default:
+				break;
+			}
+			line = end == chunk.end ? end : end + 1;
+		}
+	}
+
+	/*!
+	 * @brief ___ObjParser::Parse___
+	 * ****************************************************************************************************
+	 * Parses an OBJ file by the rules listed in objparser.h.
+	 * ****************************************************************************************************
+	 * @param filename
+	 * : Path of the .obj file.
+	 * @param positions, normals, texcoords, triangles
+	 * : Empty containers to parse into.
+	 * @param load_nml_coord_flag
+	 * : Fill normals, from the file or computed.
+	 * @param load_tex_coord_flag
+	 * : Fill texcoords, if the file has texture coordinates.
+	 * @param model_centered_flag
+	 * : Translate the positions so the center of their bounding box is at
+	 * the origin.
+	 * @param pool
+	 * : Threads to parse the chunks on, along with the caller, which parses
+	 * them alone if null. Parsing does not spawn threads of its own.
+	 * @return bool
+	 * : False, after printing why, if the file could not be mapped, has no
+	 * positions or an index out of range.
+	 * ****************************************************************************************************
+	*/
+	bool Parse(std::string const& filename,
+		std::vector<glm::vec3>& positions,
+		std::vector<glm::vec3>& normals,
+		std::vector<glm::vec2>& texcoords,
+		std::vector<uint32_t>& triangles,
+		bool load_nml_coord_flag,
+		bool load_tex_coord_flag,
+		bool model_centered_flag,
+		ThreadPool* pool)
+	{
+		MappedFile file;
+		if (!file.Open(filename))
+		{
+			std::cout << "parse " << filename << " failed, it could not be read" << std::endl;
+			return false;
+		}
+		char const* text = reinterpret_cast<char const*>(file.GetData());
+		size_t size = file.GetSize();
+
+		// chunks of whole lines, a few per thread so they even out
+		ThreadPool caller_only(0);
+		ThreadPool& workers = pool ? *pool : caller_only;
+		size_t chunk_cnt = std::max<size_t>(1, std::min<size_t>(size / min_chunk, workers.GetThreadCount() * 4));
+		std::vector<Chunk> chunks(chunk_cnt);
+		char const* begin = text;
+		for (size_t c = 0; c < chunk_cnt; ++c)
+		{
+			char const* end = c + 1 == chunk_cnt ? text + size : std::max(begin, text + size * (c + 1) / chunk_cnt);
+			end = end == text + size ? end : LineEnd(end, text + size);
+			end = end == text + size ? end : end + 1;
+			chunks[c].begin = begin;
+			chunks[c].end = end;
+			begin = end;
+		}
+
+		// pass 1: records per chunk, so every chunk knows where its
+		// attributes go and what its relative indices refer to
+		workers.ParallelFor(static_cast<unsigned>(chunk_cnt), [&](unsigned c) { Count(chunks[c]); });
+		uint32_t totals[3] = {};
+		for (Chunk& chunk : chunks)
+		{
+			for (int a = 0; a < 3; ++a)
+			{
+				chunk.bases[a] = totals[a];
+				totals[a] += chunk.counts[a];
+			}
+		}
+		if (totals[0] == 0)
+		{
+			std::cout << "parse " << filename << " failed, it has no positions" << std::endl;
+			return false;
+		}
+
+		// pass 2: attributes and triangles
+		std::vector<glm::vec3> v(totals[0]), vn(totals[2]);
+		std::vector<glm::vec2> vt(totals[1]);
+		workers.ParallelFor(static_cast<unsigned>(chunk_cnt), [&](unsigned c)
+		{
+			ParseChunk(chunks[c], totals, v.data(), vt.data(), vn.data());
+		});
+		for (Chunk const& chunk : chunks)
+		{
+			if (chunk.failed)
+			{
+				std::cout << "parse " << filename << " failed, a face has an index out of range" << std::endl;
+				return false;
+			}
+		}
+
+		// merge: vertex i is position i with the attributes of its first
+		// corner, corners that disagree with them get a vertex of their own
+		bool file_tex = load_tex_coord_flag && totals[1] > 0;
+		bool file_nml = load_nml_coord_flag && totals[2] > 0;
+		std::vector<Corner> vertices(totals[0]);
+		std::vector<unsigned char> used(totals[0], 0);
+		for (uint32_t p = 0; p < totals[0]; ++p)
+		{
+			vertices[p] = { static_cast<int32_t>(p), absent, absent };
+		}
+		struct Hash
+		{
+			size_t operator()(Corner const& c) const
+			{
+				return (static_cast<size_t>(c.p) * 0x9E3779B1u) ^ (static_cast<size_t>(c.t) * 0x85EBCA77u) ^ (static_cast<size_t>(c.n) * 0xC2B2AE3Du);
+			}
+		};
+		struct Equal
+		{
+			bool operator()(Corner const& a, Corner const& b) const
+			{
+				return a.p == b.p && a.t == b.t && a.n == b.n;
+			}
+		};
+		std::unordered_map<Corner, uint32_t, Hash, Equal> split;
+		std::vector<uint32_t> indices;
+		size_t corner_cnt = 0;
+		for (Chunk const& chunk : chunks)
+		{
+			corner_cnt += chunk.corners.size();
+		}
+		indices.reserve(corner_cnt);
+		for (Chunk const& chunk : chunks)
+		{
+			for (Corner c : chunk.corners)
+			{
+				c.t = file_tex ? c.t : absent;
+				c.n = file_nml ? c.n : absent;
+				if (!used[c.p])
+				{
+					used[c.p] = 1;
+					vertices[c.p] = c;
+					indices.push_back(c.p);
+				}
+				else if (Equal()(vertices[c.p], c))
+				{
+					indices.push_back(c.p);
+				}
+				else
+				{
+					auto found = split.emplace(c, static_cast<uint32_t>(vertices.size()));
+					if (found.second)
+					{
+						vertices.push_back(c);
+					}
+					indices.push_back(found.first->second);
+				}
+			}
+		}
+		if (model_centered_flag)
+		{
+			glm::vec3 lo(v[0]), hi(v[0]);
+			for (glm::vec3 const& p : v)
+			{
+				lo = glm::min(lo, p);
+				hi = glm::max(hi, p);
+			}
+			glm::vec3 center = (lo + hi) * 0.5f;
+			for (glm::vec3& p : v)
+			{
+				p -= center;
+			}
+		}
+
+		positions.resize(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			positions[i] = v[vertices[i].p];
+		}
+		if (file_tex)
+		{
+			texcoords.resize(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				texcoords[i] = vertices[i].t == absent ? glm::vec2(0.f) : vt[vertices[i].t];
+			}
+		}
+		if (load_nml_coord_flag)
+		{
+			// area weighted normals around each position, for the vertices
+			// the file gives none
+			std::vector<glm::vec3> computed;
+			auto missing = [](Corner const& c) { return c.n == absent; };
+			if (std::any_of(vertices.begin(), vertices.end(), missing))
+			{
+				computed.assign(totals[0], glm::vec3(0.f));
+				for (size_t i = 0; i + 2 < indices.size(); i += 3)
+				{
+					int32_t a = vertices[indices[i]].p, b = vertices[indices[i + 1]].p, c = vertices[indices[i + 2]].p;
+					glm::vec3 n = glm::cross(v[b] - v[a], v[c] - v[a]);
+					computed[a] += n;
+					computed[b] += n;
+					computed[c] += n;
+				}
+				for (glm::vec3& n : computed)
+				{
+					float length = glm::length(n);
+					n = length > 0.f ? n / length : n;
+				}
+			}
+			normals.resize(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				normals[i] = missing(vertices[i]) ? computed[vertices[i].p] : vn[vertices[i].n];
+			}
+		}
+		triangles = std::move(indices);
+		return true;
+	}
+}
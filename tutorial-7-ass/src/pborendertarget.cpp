@@ -0,0 +1,162 @@
+/* !
+@file    pborendertarget.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of class PboRenderTarget declared in
+pborendertarget.h, the render target that streams the emulator's images to a
+texture through a ring of persistently mapped PBOs.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "pborendertarget.h"
+#include <algorithm>
+#include <chrono>
+
+/*!
+ * @brief ___PboRenderTarget::PboRenderTarget___
+ * ****************************************************************************************************
+ * Creates ring_size PBOs with an image store of w x h RGBA pixels each,
+ * maps them once for good, and a texture object with the same dimensions.
+ * ****************************************************************************************************
+*/
+PboRenderTarget::PboRenderTarget(GLsizei w, GLsizei h) :
+	RenderTarget(w, h, ring_size), frame_cnt(0), wait_cnt(0), upload_bytes(0), wait_seconds(0.0)
+{
+	// create the pbos, immutable storage that may stay mapped while the gpu
+	// reads from it, writes are visible to the gpu without a flush
+	GLsizeiptr size = static_cast<GLsizeiptr>(w) * h * sizeof(GLPbo::Color);
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glCreateBuffers(ring_size, pboids);
+	for (int i = 0; i < ring_size; ++i)
+	{
+		glNamedBufferStorage(pboids[i], size, nullptr, flags);
+		mapped[i] = reinterpret_cast<GLPbo::Color*>(glMapNamedBufferRange(pboids[i], 0, size, flags));
+		fences[i] = 0;
+	}
+
+	// create the texture and allocate gpu storage for it
+	glCreateTextures(GL_TEXTURE_2D, 1, &texid);
+	glTextureStorage2D(texid, 1, GL_RGBA8, width, height);
+}
+
+/*!
+ * @brief ___PboRenderTarget::~PboRenderTarget___
+ * ****************************************************************************************************
+ * Frees the fences, pbos and texture in the hardware. Deleting a mapped
+ * buffer unmaps it.
+ * ****************************************************************************************************
+*/
+PboRenderTarget::~PboRenderTarget()
+{
+	for (GLsync fence : fences)
+	{
+		if (fence)
+		{
+			glDeleteSync(fence);
+		}
+	}
+	glDeleteBuffers(ring_size, pboids);
+	glDeleteTextures(1, &texid);
+}
+
+/*!
+ * @brief ___PboRenderTarget::Map___
+ * ****************************************************************************************************
+ * Moves on to the next PBO of the ring and returns its persistent address.
+ * If the copy out of it that was started ring_size frames ago has not
+ * finished yet, waits for its fence first and adds the time to the wait
+ * statistics.
+ * ****************************************************************************************************
+*/
+GLPbo::Color* PboRenderTarget::Map()
+{
+	buffer = (buffer + 1) % ring_size;
+	++frame_cnt;
+
+	GLsync& fence = fences[buffer];
+	if (fence)
+	{
+		// polls first, so frames that never block are not timed
+		GLenum status = glClientWaitSync(fence, 0, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			auto start = std::chrono::steady_clock::now();
+			GLuint64 const second = 1000000000;
+			do
+			{
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, second);
+			} while (status == GL_TIMEOUT_EXPIRED);
+			wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			++wait_cnt;
+		}
+		glDeleteSync(fence);
+		fence = 0;
+	}
+	return mapped[buffer];
+}
+
+/*!
+ * @brief ___PboRenderTarget::Unmap___
+ * ****************************************************************************************************
+ * Copies the changed tiles of the current pbo to the texture (DMA), and
+ * fences the copy so the pbo is not written again before the gpu is done
+ * reading it. The pbo itself stays mapped. Runs of changed tiles in a row
+ * of tiles are copied as one rectangle, which grows down over the rows
+ * below as long as they have the same run.
+ * ****************************************************************************************************
+*/
+void PboRenderTarget::Unmap()
+{
+	// binds the pbo buffer, glTextureSubImage2D then reads rectangles of
+	// width wide rows from it
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboids[buffer]);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+
+	GLint const tile = GLPbo::tile_size;
+	GLint rows = static_cast<GLint>(changed.size()) / tile_cols;
+	auto upload = [this](GLint x, GLint y, GLint w, GLint h)
+	{
+		GLintptr offset = (static_cast<GLintptr>(y) * width + x) * sizeof(GLPbo::Color);
+		glTextureSubImage2D(texid, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void const*>(offset));
+		upload_bytes += static_cast<unsigned long long>(w) * h * sizeof(GLPbo::Color);
+	};
+	for (GLint ty = 0; ty < rows; ++ty)
+	{
+		unsigned char const* row = &changed[static_cast<size_t>(ty) * tile_cols];
+		for (GLint tx0 = 0; tx0 < tile_cols; ++tx0)
+		{
+			if (!row[tx0])
+			{
+				continue;
+			}
+			GLint tx1 = tx0 + 1;
+			while (tx1 < tile_cols && row[tx1])
+			{
+				++tx1;
+			}
+			// take the same run off the rows below, it is part of this rectangle
+			GLint ty1 = ty + 1;
+			while (ty1 < rows
+				&& std::all_of(&changed[static_cast<size_t>(ty1) * tile_cols + tx0], &changed[static_cast<size_t>(ty1) * tile_cols + tx1], [](unsigned char c) { return c != 0; })
+				&& (tx0 == 0 || !changed[static_cast<size_t>(ty1) * tile_cols + tx0 - 1])
+				&& (tx1 == tile_cols || !changed[static_cast<size_t>(ty1) * tile_cols + tx1]))
+			{
+				std::fill(&changed[static_cast<size_t>(ty1) * tile_cols + tx0], &changed[static_cast<size_t>(ty1) * tile_cols + tx1], 0);
+				++ty1;
+			}
+			GLint x = tx0 * tile, y = ty * tile;
+			upload(x, y, std::min(tx1 * tile, width) - x, std::min(ty1 * tile, height) - y);
+			tx0 = tx1;
+		}
+	}
+
+	// unbind buffer
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	fences[buffer] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	EndFrame();
+}
@@ -0,0 +1,3179 @@
+/* !
+@file    rasterizer.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the static member functions declared in
+glpbo.h that make up the graphics pipe emulator itself: clearing buffers,
+transforming models and rasterizing lines and triangles into
+GLPbo::ptr_to_pbo, or into a block layout color buffer that is detiled into
+it. None of them call OpenGL, the functions that stream the emulator's
+images to the GPU are in glpbo.cpp.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include "rendertarget.h"
+#include "scene.h"
+#include "shaders.h"
+#include "threadpool.h"
+#include "simd.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+
+/*                                                         static member data
+----------------------------------------------------------------------------- */
+GLsizei GLPbo::pixel_cnt, GLPbo::byte_cnt, GLPbo::height, GLPbo::width;
+GLPbo::Color* GLPbo::ptr_to_pbo{nullptr};
+GLPbo::Color GLPbo::clear_clr;
+GLPbo::Model GLPbo::cube;
+bool GLPbo::tiled{ false };
+bool GLPbo::fixed_point{ false };
+bool GLPbo::depth_test{ false };
+bool GLPbo::backface_culling{ true };
+bool GLPbo::cluster_culling{ true };
+bool GLPbo::block_layout{ false };
+bool GLPbo::dirty_tiles{ true };
+bool GLPbo::fast_clear{ true };
+std::vector<unsigned char> GLPbo::drawn_tiles;
+std::vector<GLfloat> GLPbo::depth_buffer;
+GLfloat GLPbo::clear_depth{ 1.0f };
+
+// hierarchical rasterization and hierarchical z work on screen aligned blocks
+// of this size, GLPbo::tile_size is a multiple of it so blocks never straddle
+// two tiles
+constexpr GLint block_size = GLPbo::block_size;
+static_assert(GLPbo::tile_size % block_size == 0, "tiles must be made of whole blocks");
+static_assert(block_size % SIMD::width == 0, "block rows are detiled SIMD::width pixels at a time");
+
+/*!
+ * @brief ___StreamFill___
+ * *******************************
+ * Fills count pixels from dst with clr using non-temporal stores, which
+ * write around the cache instead of evicting it for pixels nobody reads
+ * before they are presented. The caller issues SIMD::Fence() once done.
+*/
+static void StreamFill(GLPbo::Color* dst, size_t count, GLPbo::Color clr)
+{
+	uint32_t* p = &dst->raw;
+	uint32_t* end = p + count;
+	// streaming stores must be aligned to whole registers
+	while (p < end && reinterpret_cast<uintptr_t>(p) % (SIMD::width * sizeof(uint32_t)) != 0)
+	{
+		*p++ = clr.raw;
+	}
+	SIMD::Int v = SIMD::Set1(static_cast<int32_t>(clr.raw));
+	for (; end - p >= SIMD::width; p += SIMD::width)
+	{
+		SIMD::Stream(p, v);
+	}
+	std::fill(p, end, clr.raw);
+}
+
+/*!
+ * @brief ___Blocks___
+ * *********************
+ * Namespace that holds the color buffer of GLPbo::block_layout, and maps
+ * pixels to their place in the color and depth buffers in either layout.
+ * In both, the pixels of a row that lie in the same block are contiguous,
+ * which is all the span kernels rely on.
+*/
+namespace Blocks
+{
+	constexpr GLint		pixels = block_size * block_size;	/*!< per block */
+	constexpr size_t	alignment = 64;						/*!< every block starts on a cache line */
+
+	std::vector<unsigned char>	storage;			/*!< over-allocated by alignment bytes */
+	GLPbo::Color*				color = nullptr;	/*!< first aligned pixel in storage */
+	GLint						cols = 0;			/*!< blocks per row */
+	size_t						count = 0;			/*!< pixels in whole blocks, at least GLPbo::pixel_cnt */
+
+	/*!
+	 * @brief ___Blocks::Init___
+	 * *******************************
+	 * Allocates the color buffer, padded to whole blocks.
+	*/
+	void Init()
+	{
+		cols = (GLPbo::width + block_size - 1) / block_size;
+		GLint rows = (GLPbo::height + block_size - 1) / block_size;
+		count = static_cast<size_t>(cols) * rows * pixels;
+		storage.assign(count * sizeof(GLPbo::Color) + alignment, 0);
+		void* ptr = storage.data();
+		size_t space = storage.size();
+		color = static_cast<GLPbo::Color*>(std::align(alignment, space - alignment, ptr, space));
+	}
+
+	// index of pixel (x, y) in the color and depth buffers
+	inline size_t Offset(GLint x, GLint y)
+	{
+		if (!GLPbo::block_layout)
+		{
+			return static_cast<size_t>(y) * GLPbo::width + x;
+		}
+		unsigned ux = static_cast<unsigned>(x), uy = static_cast<unsigned>(y);
+		size_t block = static_cast<size_t>(uy / block_size) * cols + ux / block_size;
+		return block * pixels + (uy % block_size) * block_size + ux % block_size;
+	}
+
+	// pixel (x, y) of the color buffer triangles and lines are drawn into
+	inline GLPbo::Color* ColorAt(GLint x, GLint y)
+	{
+		return (GLPbo::block_layout ? color : GLPbo::ptr_to_pbo) + Offset(x, y);
+	}
+
+	// depth of pixel (x, y)
+	inline GLfloat* DepthAt(GLint x, GLint y)
+	{
+		return GLPbo::depth_buffer.data() + Offset(x, y);
+	}
+
+	// fills count pixels from dst with clr, SIMD::width at a time
+	inline void FillRun(GLPbo::Color* dst, size_t count, GLPbo::Color clr)
+	{
+		uint32_t* p = &dst->raw;
+		uint32_t* end = p + count;
+		SIMD::Int v = SIMD::Set1(static_cast<int32_t>(clr.raw));
+		for (; end - p >= SIMD::width; p += SIMD::width)
+		{
+			SIMD::Store(p, v);
+		}
+		std::fill(p, end, clr.raw);
+	}
+
+	/*!
+	 * @brief ___Blocks::Fill___
+	 * *******************************
+	 * Fills [x0,x1) x [y0,y1) of the color buffer triangles and lines are
+	 * drawn into with clr, x0 and y0 on a block boundary. In block layout
+	 * the partial blocks on the screen border are filled whole, every block
+	 * row of the rectangle is then one contiguous run.
+	*/
+	void Fill(GLint x0, GLint y0, GLint x1, GLint y1, GLPbo::Color clr)
+	{
+		if (!GLPbo::block_layout)
+		{
+			for (GLint y = y0; y < y1; ++y)
+			{
+				FillRun(GLPbo::ptr_to_pbo + static_cast<size_t>(y) * GLPbo::width + x0, x1 - x0, clr);
+			}
+			return;
+		}
+		size_t run = static_cast<size_t>((x1 - x0 + block_size - 1) / block_size) * pixels;
+		for (GLint y = y0; y < y1; y += block_size)
+		{
+			FillRun(ColorAt(x0, y), run, clr);
+		}
+	}
+
+	/*!
+	 * @brief ___Blocks::Detile___
+	 * *******************************
+	 * Copies [x0,x1) x [y0,y1) of the color buffer into GLPbo::ptr_to_pbo,
+	 * x0 on a block boundary. The target is written row by row, so its
+	 * stores are sequential, while the reads stay within the 8 blocks of a
+	 * 64 pixel wide tile, 2 KiB that remain cached for all 8 rows of a block
+	 * row. Block rows move SIMD::width pixels per load and store.
+	*/
+	void Detile(GLint x0, GLint y0, GLint x1, GLint y1)
+	{
+		GLint whole = x0 + (x1 - x0) / block_size * block_size;
+		for (GLint y = y0; y < y1; ++y)
+		{
+			uint32_t const* src = &color[Offset(x0, y)].raw;
+			uint32_t* dst = &GLPbo::ptr_to_pbo[static_cast<size_t>(y) * GLPbo::width + x0].raw;
+			for (GLint x = x0; x < whole; x += block_size, src += pixels, dst += block_size)
+			{
+				for (GLint i = 0; i < block_size; i += SIMD::width)
+				{
+					SIMD::Store(dst + i, SIMD::Load(src + i));
+				}
+			}
+			// the partial block on the right border of the screen
+			std::copy(src, src + (x1 - whole), dst);
+		}
+	}
+}
+
+/*!
+ * @brief ___Tiles___
+ * *********************
+ * Namespace that holds the state of the tile binned rasterizer.
+*/
+namespace Tiles
+{
+	std::vector<GLPbo::TriangleSetup>	setups;		/*!< triangles binned this frame, in submission order */
+	std::vector<std::vector<GLuint>>	bins;		/*!< per tile indices into setups */
+	GLint								cols = 0;	/*!< tiles per row */
+	std::unique_ptr<ThreadPool>			workers;
+	std::vector<std::shared_ptr<void>>	shaders;	/*!< copies of the shaders binned triangles point to */
+	void const*							last_type;	/*!< identifies the type of shaders.back() */
+
+	// GLPbo::fast_clear
+	std::vector<unsigned char>			cleared;			/*!< per tile, set while the tile is cleared but its pixels are not written yet */
+	GLPbo::Color						cleared_to;			/*!< clear color of the flagged tiles */
+	std::vector<unsigned char> const*	stale = nullptr;	/*!< RenderTarget::GetStale() of the frame being drawn, null if untracked */
+
+	/*!
+	 * @brief ___Tiles::Init___
+	 * *******************************
+	 * Allocates one bin per screen tile and spawns a worker for every core
+	 * but the one running the main thread.
+	*/
+	void Init()
+	{
+		cols = (GLPbo::width + GLPbo::tile_size - 1) / GLPbo::tile_size;
+		GLint rows = (GLPbo::height + GLPbo::tile_size - 1) / GLPbo::tile_size;
+		bins.assign(static_cast<size_t>(cols) * rows, {});
+		GLPbo::drawn_tiles.assign(static_cast<size_t>(cols) * rows, 1);
+		cleared.assign(static_cast<size_t>(cols) * rows, 0);
+		unsigned cores = std::thread::hardware_concurrency();
+		workers = std::make_unique<ThreadPool>(cores > 1 ? cores - 1 : 0);
+	}
+
+	/*!
+	 * @brief ___Tiles::Keep___
+	 * *******************************
+	 * Returns a copy of shader that lives until resolve_tiles(), the caller's
+	 * may be gone by the time binned triangles are rasterized. Consecutive
+	 * draws with an identical shader share one copy.
+	*/
+	template <typename Shader>
+	Shader const* Keep(Shader const& shader)
+	{
+		static_assert(std::is_trivially_copyable<Shader>::value, "shaders are plain structs of uniforms");
+		static char const type = 0;
+		if (shaders.empty() || last_type != &type || std::memcmp(shaders.back().get(), &shader, sizeof(Shader)) != 0)
+		{
+			shaders.push_back(std::make_shared<Shader>(shader));
+			last_type = &type;
+		}
+		return static_cast<Shader const*>(shaders.back().get());
+	}
+
+	/*!
+	 * @brief ___Tiles::Clear___
+	 * *******************************
+	 * Fills the flagged tiles of GLPbo::ptr_to_pbo with the clear color, runs
+	 * of flagged tiles a row at a time, with non-temporal stores.
+	*/
+	void Clear(std::vector<unsigned char> const& tiles)
+	{
+		GLint rows = static_cast<GLint>(tiles.size()) / cols;
+		for (GLint ty = 0; ty < rows; ++ty)
+		{
+			unsigned char const* flags = &tiles[static_cast<size_t>(ty) * cols];
+			for (GLint tx0 = 0; tx0 < cols; ++tx0)
+			{
+				if (!flags[tx0])
+				{
+					continue;
+				}
+				GLint tx1 = tx0 + 1;
+				while (tx1 < cols && flags[tx1])
+				{
+					++tx1;
+				}
+				GLint x0 = tx0 * GLPbo::tile_size, x1 = std::min(tx1 * GLPbo::tile_size, GLPbo::width);
+				GLint y0 = ty * GLPbo::tile_size, y1 = std::min(y0 + GLPbo::tile_size, GLPbo::height);
+				for (GLint y = y0; y < y1; ++y)
+				{
+					StreamFill(GLPbo::ptr_to_pbo + static_cast<size_t>(y) * GLPbo::width + x0, x1 - x0, GLPbo::clear_clr);
+				}
+				tx0 = tx1;
+			}
+		}
+		SIMD::Fence();
+	}
+
+	/*!
+	 * @brief ___Tiles::Defer___
+	 * *******************************
+	 * The fast clear: flags the tiles that have to be cleared, without
+	 * writing any pixel. Tiles of the render target that are not stale
+	 * already hold the clear color, unless the block layout color buffer is
+	 * drawn into.
+	*/
+	void Defer()
+	{
+		if (stale && !GLPbo::block_layout)
+		{
+			cleared = *stale;
+		}
+		else
+		{
+			std::fill(cleared.begin(), cleared.end(), 1);
+		}
+		cleared_to = GLPbo::clear_clr;
+	}
+
+	/*!
+	 * @brief ___Tiles::Fill___
+	 * *******************************
+	 * Writes the clear color of a flagged tile into the color buffer right
+	 * before it is first drawn into. Plain stores, the tile is about to be
+	 * rasterized so it should be in cache.
+	*/
+	void Fill(size_t tile)
+	{
+		cleared[tile] = 0;
+		GLint x0 = static_cast<GLint>(tile % cols) * GLPbo::tile_size, y0 = static_cast<GLint>(tile / cols) * GLPbo::tile_size;
+		Blocks::Fill(x0, y0, std::min(x0 + GLPbo::tile_size, GLPbo::width), std::min(y0 + GLPbo::tile_size, GLPbo::height), cleared_to);
+	}
+
+	/*!
+	 * @brief ___Tiles::Resolve___
+	 * *******************************
+	 * Brings a tile of GLPbo::ptr_to_pbo up to date once nothing more is
+	 * drawn into it: a tile still flagged as cleared is filled with its clear
+	 * color, with non-temporal stores and only if the render target does not
+	 * hold it cleared already, and a tile drawn in block layout is detiled.
+	*/
+	void Resolve(size_t tile)
+	{
+		GLint x0 = static_cast<GLint>(tile % cols) * GLPbo::tile_size, y0 = static_cast<GLint>(tile / cols) * GLPbo::tile_size;
+		GLint x1 = std::min(x0 + GLPbo::tile_size, GLPbo::width), y1 = std::min(y0 + GLPbo::tile_size, GLPbo::height);
+		if (cleared[tile])
+		{
+			cleared[tile] = 0;
+			if (!stale || (*stale)[tile])
+			{
+				for (GLint y = y0; y < y1; ++y)
+				{
+					StreamFill(GLPbo::ptr_to_pbo + static_cast<size_t>(y) * GLPbo::width + x0, x1 - x0, cleared_to);
+				}
+				SIMD::Fence();
+			}
+		}
+		else if (GLPbo::block_layout)
+		{
+			Blocks::Detile(x0, y0, x1, y1);
+		}
+	}
+
+	// flags the tiles [x0,x1) x [y0,y1) touches in GLPbo::drawn_tiles, and
+	// fills those still flagged as cleared
+	inline void Touch(GLint x0, GLint y0, GLint x1, GLint y1)
+	{
+		for (GLint ty = y0 / GLPbo::tile_size; ty <= (y1 - 1) / GLPbo::tile_size; ++ty)
+		{
+			for (GLint tx = x0 / GLPbo::tile_size; tx <= (x1 - 1) / GLPbo::tile_size; ++tx)
+			{
+				size_t tile = static_cast<size_t>(ty) * cols + tx;
+				if (cleared[tile])
+				{
+					Fill(tile);
+				}
+				GLPbo::drawn_tiles[tile] = 1;
+			}
+		}
+	}
+
+	void Bin(GLPbo::TriangleSetup const& setup);
+}
+
+/*!
+ * @brief ___HiZ___
+ * *********************
+ * Namespace that holds the hierarchical z buffer, the smallest and largest
+ * depth of every block of the depth buffer. A triangle whose nearest depth
+ * over a block is not less than the block's largest depth cannot pass the
+ * depth test anywhere in it.
+*/
+namespace HiZ
+{
+	std::vector<GLfloat>	zmin, zmax;		/*!< per block depth bounds */
+	std::vector<uint64_t>	covered;		/*!< per block pixels written since zmax was last lowered, bit (y * block_size + x) */
+	std::vector<GLfloat>	zlayer;			/*!< per block largest depth written since zmax was last lowered */
+	GLint					cols = 0;		/*!< blocks per row */
+
+	/*!
+	 * @brief ___HiZ::Init___
+	 * *******************************
+	 * Allocates the bounds of every block of the depth buffer.
+	*/
+	void Init()
+	{
+		cols = (GLPbo::width + block_size - 1) / block_size;
+		GLint rows = (GLPbo::height + block_size - 1) / block_size;
+		zmin.assign(static_cast<size_t>(cols) * rows, GLPbo::clear_depth);
+		zmax.assign(static_cast<size_t>(cols) * rows, GLPbo::clear_depth);
+		covered.assign(static_cast<size_t>(cols) * rows, 0);
+		zlayer.assign(static_cast<size_t>(cols) * rows, 0.f);
+	}
+
+	// resets every block to a depth buffer cleared to depth
+	void Clear(GLfloat depth)
+	{
+		std::fill(zmin.begin(), zmin.end(), depth);
+		std::fill(zmax.begin(), zmax.end(), depth);
+		std::fill(covered.begin(), covered.end(), 0);
+		std::fill(zlayer.begin(), zlayer.end(), 0.f);
+	}
+
+	// index of the block that holds pixel (x, y)
+	inline size_t Index(GLint x, GLint y)
+	{
+		return static_cast<size_t>(y / block_size) * cols + x / block_size;
+	}
+
+	/*!
+	 * @brief ___HiZ::Update___
+	 * *******************************
+	 * Updates the bounds of the block at (bx, by) after a triangle with
+	 * depths [zlo, zhi] over the block wrote the pixels in bits. Once every
+	 * pixel of the block has been written, none of them is farther than the
+	 * largest depth written meanwhile, which becomes the new zmax. This keeps
+	 * zmax dropping as layers of small triangles cover the block, without
+	 * ever reading the depth buffer back.
+	*/
+	void Update(GLint bx, GLint by, GLfloat zlo, GLfloat zhi, uint64_t bits)
+	{
+		size_t i = Index(bx, by);
+		zmin[i] = std::min(zmin[i], zlo);
+		zlayer[i] = std::max(zlayer[i], zhi);
+		covered[i] |= bits;
+
+		// blocks on the right and top borders of the screen are partial
+		GLint w = std::min(block_size, GLPbo::width - bx), h = std::min(block_size, GLPbo::height - by);
+		uint64_t row = (uint64_t(1) << w) - 1, all = 0;
+		for (GLint y = 0; y < h; ++y)
+		{
+			all |= row << (y * block_size);
+		}
+		if (covered[i] == all)
+		{
+			zmax[i] = std::min(zmax[i], zlayer[i]);
+			covered[i] = 0;
+			zlayer[i] = 0.f;
+		}
+	}
+}
+
+/*!
+ * @brief ___Clip___
+ * *********************
+ * Namespace that holds the clip stage. Triangles crossing the near or far
+ * plane are clipped in clip coordinates before the perspective divide.
+ * After it, triangles entirely outside the viewport are rejected, triangles
+ * inside the guard band go straight to setup, and only triangles leaving the
+ * guard band are clipped to it with Sutherland-Hodgman and drawn as a fan.
+*/
+namespace Clip
+{
+	using Vertex = GLPbo::Vertex;
+
+	/*!
+	 * @brief ___Clip::Homogeneous___
+	 * Clip coordinates and the varyings interpolated along with them, not
+	 * yet divided by w.
+	*/
+	struct Homogeneous
+	{
+		glm::vec4	p;
+		GLfloat		v[GLPbo::max_varyings];
+	};
+
+	// every clip plane adds at most one vertex to the polygon, a triangle
+	// is clipped to near and far, then to the 4 guard band planes
+	constexpr int max_vertices = 3 + 2 + 4;
+
+	enum class Result
+	{
+		Outside,	/*!< covers no part of the viewport */
+		GuardBand,	/*!< every vertex is in the guard band, needs no clipping */
+		Overflow	/*!< leaves the guard band, needs clipping */
+	};
+
+	// sides of [x0, x1] x [y0, y1] that p lies outside of
+	inline int Outcode(glm::vec3 const& p, float x0, float y0, float x1, float y1)
+	{
+		return (p.x < x0 ? 1 : 0) | (p.x > x1 ? 2 : 0) | (p.y < y0 ? 4 : 0) | (p.y > y1 ? 8 : 0);
+	}
+
+	/*!
+	 * @brief ___Clip::Classify___
+	 * *******************************
+	 * Decides how a polygon in window coordinates goes through the clip
+	 * stage. A polygon is outside when all its vertices lie beyond the same
+	 * viewport edge.
+	*/
+	inline Result Classify(Vertex const* poly, int n)
+	{
+		float w = static_cast<float>(GLPbo::width), h = static_cast<float>(GLPbo::height);
+		float g = static_cast<float>(GLPbo::guard_band);
+		int all = ~0, any = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			all &= Outcode(poly[i].p, 0.f, 0.f, w, h);
+			any |= Outcode(poly[i].p, -g, -g, w + g, h + g);
+		}
+		return all ? Result::Outside : any ? Result::Overflow : Result::GuardBand;
+	}
+
+	/*!
+	 * @brief ___Clip::Lerp___
+	 * Vertex at t along the edge from a to b. Window vertices carry their
+	 * varyings over w, which are linear in window coordinates, clip
+	 * vertices carry them as they are, which are linear in clip coordinates.
+	*/
+	inline Vertex Lerp(Vertex const& a, Vertex const& b, float t)
+	{
+		Vertex out;
+		out.p = a.p + (b.p - a.p) * t;
+		out.q = a.q + (b.q - a.q) * t;
+		for (int i = 0; i < GLPbo::max_varyings; ++i)
+		{
+			out.v[i] = a.v[i] + (b.v[i] - a.v[i]) * t;
+		}
+		return out;
+	}
+	inline Homogeneous Lerp(Homogeneous const& a, Homogeneous const& b, float t)
+	{
+		Homogeneous out;
+		out.p = a.p + (b.p - a.p) * t;
+		for (int i = 0; i < GLPbo::max_varyings; ++i)
+		{
+			out.v[i] = a.v[i] + (b.v[i] - a.v[i]) * t;
+		}
+		return out;
+	}
+
+	/*!
+	 * @brief ___Clip::Plane___
+	 * *******************************
+	 * Clips a polygon to the half space where distance(p) >= 0.
+	 * Intersections are always computed from the vertex inside to the one
+	 * outside, so an edge shared by two triangles is cut at the exact same
+	 * point for both, whichever way round they list it.
+	*/
+	template <typename V, typename Distance>
+	int Plane(V const* in, int n, V* out, Distance distance)
+	{
+		int m = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			V const& a = in[i];
+			V const& b = in[i + 1 < n ? i + 1 : 0];
+			float da = distance(a.p), db = distance(b.p);
+			if (da >= 0.f)
+			{
+				out[m++] = a;
+			}
+			if ((da >= 0.f) != (db >= 0.f))
+			{
+				V const& inside = da >= 0.f ? a : b;
+				V const& outside = da >= 0.f ? b : a;
+				float di = std::max(da, db), t = di / (di - std::min(da, db));
+				out[m++] = Lerp(inside, outside, t);
+			}
+		}
+		return m;
+	}
+
+	/*!
+	 * @brief ___Clip::Polygon___
+	 * *******************************
+	 * Clips the polygon in poly to the guard band, in place, and returns its
+	 * new vertex count. Fewer than 3 vertices means nothing is left.
+	*/
+	int Polygon(Vertex (&poly)[max_vertices], int n)
+	{
+		float g = static_cast<float>(GLPbo::guard_band);
+		float x1 = GLPbo::width + g, y1 = GLPbo::height + g;
+		Vertex tmp[max_vertices];
+		n = Plane(poly, n, tmp, [g](glm::vec3 const& p) { return p.x + g; });
+		n = Plane(tmp, n, poly, [x1](glm::vec3 const& p) { return x1 - p.x; });
+		n = Plane(poly, n, tmp, [g](glm::vec3 const& p) { return p.y + g; });
+		return Plane(tmp, n, poly, [y1](glm::vec3 const& p) { return y1 - p.y; });
+	}
+
+	/*!
+	 * @brief ___Clip::Triangle___
+	 * *******************************
+	 * Runs a filled triangle in window coordinates through the clip stage and
+	 * calls draw(v0, v1, v2) for each resulting triangle, in the triangle's
+	 * winding. Returns whether any call returned true.
+	*/
+	template <typename Draw>
+	bool Triangle(Vertex const& v0, Vertex const& v1, Vertex const& v2, Draw draw)
+	{
+		Vertex poly[max_vertices] = { v0, v1, v2 };
+		switch (Classify(poly, 3))
+		{
+		case Result::Outside:
+			return false;
+		case Result::GuardBand:
+			return draw(v0, v1, v2);
+		default:
+			break;
+		}
+
+		int n = Polygon(poly, 3);
+		bool drawn = false;
+		for (int i = 1; i + 1 < n; ++i)
+		{
+			drawn = draw(poly[0], poly[i], poly[i + 1]) || drawn;
+		}
+		return drawn;
+	}
+
+	/*!
+	 * @brief ___Clip::ToWindow___
+	 * *******************************
+	 * Perspective divide and viewport mapping of one vertex, the exact same
+	 * operations GLPbo::transform_vertices() does SIMD::width at a time.
+	*/
+	inline Vertex ToWindow(Homogeneous const& v)
+	{
+		float inv_w = 1.f / v.p.w;
+		Vertex out;
+		out.p = { (v.p.x * inv_w + 1.f) * 0.5f * GLPbo::width,
+			(v.p.y * inv_w + 1.f) * 0.5f * GLPbo::height,
+			(v.p.z * inv_w + 1.f) * 0.5f };
+		out.q = inv_w;
+		for (int i = 0; i < GLPbo::max_varyings; ++i)
+		{
+			out.v[i] = v.v[i] * inv_w;
+		}
+		return out;
+	}
+
+	/*!
+	 * @brief ___Clip::Window___
+	 * *******************************
+	 * Window vertex p with 1 / w of q and varyings_cnt varyings from
+	 * varyings, which may be null if there are none.
+	*/
+	inline Vertex Window(glm::vec3 const& p, float q, GLfloat const* varyings, int varying_cnt)
+	{
+		Vertex out;
+		out.p = p;
+		out.q = q;
+		for (int i = 0; i < varying_cnt; ++i)
+		{
+			out.v[i] = varyings[i] * q;
+		}
+		return out;
+	}
+
+	/*!
+	 * @brief ___Clip::Assemble___
+	 * *******************************
+	 * Assembles the triangle (i0, i1, i2) of a transformed model with
+	 * varying_cnt varyings per vertex, laid out one vertex after the other
+	 * in varyings, and calls draw(poly, n) with it as a polygon in window
+	 * coordinates, clipped to the near and far planes if needed. Returns
+	 * what draw returned, or false if the triangle lies beyond either plane.
+	*/
+	template <typename Draw>
+	bool Assemble(GLPbo::Model const& model, GLuint i0, GLuint i1, GLuint i2,
+		GLfloat const* varyings, int varying_cnt, Draw draw)
+	{
+		unsigned char code0 = model.clip[i0], code1 = model.clip[i1], code2 = model.clip[i2];
+		if (code0 & code1 & code2)
+		{
+			return false;
+		}
+		auto varyings_of = [varyings, varying_cnt](GLuint i) { return varyings ? varyings + static_cast<size_t>(i) * varying_cnt : nullptr; };
+		if (!(code0 | code1 | code2))
+		{
+			Vertex poly[3] = {
+				Window(model.window(i0), model.qd[i0], varyings_of(i0), varying_cnt),
+				Window(model.window(i1), model.qd[i1], varyings_of(i1), varying_cnt),
+				Window(model.window(i2), model.qd[i2], varyings_of(i2), varying_cnt) };
+			return draw(poly, 3);
+		}
+
+		auto clip_vertex = [&](GLuint i)
+		{
+			Homogeneous out{};
+			out.p = glm::vec4(model.xc[i], model.yc[i], model.zc[i], model.wc[i]);
+			if (varyings)
+			{
+				std::copy(varyings_of(i), varyings_of(i) + varying_cnt, out.v);
+			}
+			return out;
+		};
+		Homogeneous poly[max_vertices] = { clip_vertex(i0), clip_vertex(i1), clip_vertex(i2) }, tmp[max_vertices];
+		int n = Plane(poly, 3, tmp, [](glm::vec4 const& p) { return p.z + p.w; });
+		n = Plane(tmp, n, poly, [](glm::vec4 const& p) { return p.w - p.z; });
+		if (n < 3)
+		{
+			return false;
+		}
+
+		Vertex window[max_vertices];
+		for (int i = 0; i < n; ++i)
+		{
+			window[i] = ToWindow(poly[i]);
+		}
+		return draw(window, n);
+	}
+}
+
+/*!
+ * @brief ___Batch___
+ * *********************
+ * Namespace that holds draw_elements()'s setup buffer. Filled triangles
+ * are gathered a batch at a time into structure of arrays form, culled and
+ * classified SIMD::width at a time, and the survivors compacted, in index
+ * order, for setup.
+*/
+namespace Batch
+{
+	// triangles per batch, a multiple of every SIMD::width
+	constexpr int size = 256;
+
+	/*!
+	 * @brief ___Batch::Positions___
+	 * Window coordinates of the 3 vertices of up to size triangles.
+	*/
+	struct Positions
+	{
+		float	x0[size], y0[size], z0[size];
+		float	x1[size], y1[size], z1[size];
+		float	x2[size], y2[size], z2[size];
+	};
+
+	Positions		gathered;				/*!< every triangle of the batch */
+	unsigned char	clip_any[size];			/*!< Model::clip bits of any vertex of gathered triangles */
+	unsigned char	clip_all[size];			/*!< Model::clip bits of every vertex of gathered triangles */
+	Positions		kept;					/*!< triangles that survived culling, meaningful where clipped is false */
+	size_t			face[size];				/*!< triangle number of each kept triangle */
+	bool			clipped[size];			/*!< kept triangle needs near, far or guard band clipping */
+	std::vector<GLfloat>	varyings;		/*!< vertex shader output of the model being drawn */
+
+	/*!
+	 * @brief ___Batch::BackFixed___
+	 * *******************************
+	 * Lane bits of the triangles SetupTriangleFixed() culls, those whose
+	 * vertices snapped to 1/16 pixel are backfacing or collinear. Snapped
+	 * coordinates in range are integers under 2^18, so they and their
+	 * differences are exact in float and only the two products round, each
+	 * by at most 2^-24 of itself. Lanes whose float area is within 2^-22 of
+	 * the products of zero are redone in 64-bit integers.
+	*/
+	inline int BackFixed(SIMD::Float x0, SIMD::Float y0, SIMD::Float x1, SIMD::Float y1, SIMD::Float x2, SIMD::Float y2)
+	{
+		// SnapFixed(), adding 0.5 to v * 16 under 2^18 is exact in float too
+		auto snap = [](SIMD::Float v)
+		{
+			SIMD::Float x = v * SIMD::Set1(static_cast<float>(1 << GLPbo::subpixel_bits));
+			SIMD::Float half = SIMD::AsFloat((SIMD::AsInt(x) & SIMD::AsInt(SIMD::Set1(-0.f))) | SIMD::AsInt(SIMD::Set1(0.5f)));
+			return SIMD::ToFloat(SIMD::Truncate(x + half));
+		};
+		x0 = snap(x0), y0 = snap(y0), x1 = snap(x1), y1 = snap(y1), x2 = snap(x2), y2 = snap(y2);
+
+		SIMD::Float zero = SIMD::Set1(0.f);
+		SIMD::Float p = (x1 - x0) * (y2 - y0), q = (x2 - x0) * (y1 - y0), area = p - q;
+		SIMD::Float error = (SIMD::Max(p, zero - p) + SIMD::Max(q, zero - q)) * SIMD::Set1(1.f / (1 << 22));
+		int back = SIMD::Bits(area < zero - error);
+		int unsure = ~(back | SIMD::Bits(area > error)) & ((1 << SIMD::width) - 1);
+		if (unsure)
+		{
+			float sx0[SIMD::width], sy0[SIMD::width], sx1[SIMD::width], sy1[SIMD::width], sx2[SIMD::width], sy2[SIMD::width];
+			SIMD::Store(sx0, x0), SIMD::Store(sy0, y0), SIMD::Store(sx1, x1), SIMD::Store(sy1, y1), SIMD::Store(sx2, x2), SIMD::Store(sy2, y2);
+			for (int lane = 0; lane < SIMD::width; ++lane)
+			{
+				if ((unsure >> lane) & 1)
+				{
+					auto fixed = [](float v) { return static_cast<long long>(v); };
+					long long double_area = (fixed(sx1[lane]) - fixed(sx0[lane])) * (fixed(sy2[lane]) - fixed(sy0[lane]))
+						- (fixed(sx2[lane]) - fixed(sx0[lane])) * (fixed(sy1[lane]) - fixed(sy0[lane]));
+					back |= (double_area <= 0 ? 1 : 0) << lane;
+				}
+			}
+		}
+		return back;
+	}
+
+	/*!
+	 * @brief ___Batch::Cull___
+	 * *******************************
+	 * Gathers triangles [first, first + n) of a transformed model, drops
+	 * those that are backfacing, outside the viewport or beyond the near or
+	 * far plane, and compacts the rest into kept, face and clipped.
+	 * Triangles that need clipping are kept without being culled, the clip
+	 * stage deals with them one at a time. Returns how many were kept.
+	*/
+	template <typename Index>
+	int Cull(GLPbo::Model const& model, Index const* tri, size_t first, int n)
+	{
+		// padding lanes are gathered as degenerate triangles and never kept
+		int lanes = (n + SIMD::width - 1) / SIMD::width * SIMD::width;
+		for (int k = 0; k < lanes; ++k)
+		{
+			GLuint i0 = 0, i1 = 0, i2 = 0;
+			if (k < n)
+			{
+				Index const* t = tri + (first + k) * 3;
+				i0 = t[0], i1 = t[1], i2 = t[2];
+			}
+			gathered.x0[k] = model.xd[i0], gathered.y0[k] = model.yd[i0], gathered.z0[k] = model.zd[i0];
+			gathered.x1[k] = model.xd[i1], gathered.y1[k] = model.yd[i1], gathered.z1[k] = model.zd[i1];
+			gathered.x2[k] = model.xd[i2], gathered.y2[k] = model.yd[i2], gathered.z2[k] = model.zd[i2];
+			clip_any[k] = model.clip[i0] | model.clip[i1] | model.clip[i2];
+			clip_all[k] = model.clip[i0] & model.clip[i1] & model.clip[i2];
+		}
+
+		bool cull = GLPbo::backface_culling;
+		float g = static_cast<float>(GLPbo::guard_band);
+		SIMD::Float range = SIMD::Set1(static_cast<float>(GLPbo::fixed_max_coord)), range0 = SIMD::Set1(-static_cast<float>(GLPbo::fixed_max_coord));
+		SIMD::Float zero = SIMD::Set1(0.f);
+		SIMD::Float w = SIMD::Set1(static_cast<float>(GLPbo::width)), h = SIMD::Set1(static_cast<float>(GLPbo::height));
+		SIMD::Float g0 = SIMD::Set1(-g), gw = SIMD::Set1(GLPbo::width + g), gh = SIMD::Set1(GLPbo::height + g);
+
+		int count = 0;
+		for (int k = 0; k < n; k += SIMD::width)
+		{
+			SIMD::Float x0 = SIMD::Load(gathered.x0 + k), y0 = SIMD::Load(gathered.y0 + k);
+			SIMD::Float x1 = SIMD::Load(gathered.x1 + k), y1 = SIMD::Load(gathered.y1 + k);
+			SIMD::Float x2 = SIMD::Load(gathered.x2 + k), y2 = SIMD::Load(gathered.y2 + k);
+			SIMD::Float xmin = SIMD::Min(SIMD::Min(x0, x1), x2), xmax = SIMD::Max(SIMD::Max(x0, x1), x2);
+			SIMD::Float ymin = SIMD::Min(SIMD::Min(y0, y1), y2), ymax = SIMD::Max(SIMD::Max(y0, y1), y2);
+
+			// same tests as Clip::Classify() and setup_triangle()
+			int outside = SIMD::Bits((xmax < zero) | (xmin > w) | (ymax < zero) | (ymin > h));
+			int overflow = SIMD::Bits((xmin < g0) | (xmax > gw) | (ymin < g0) | (ymax > gh));
+			int back = cull ? SIMD::Bits((x0 - x1) * (y2 - y1) - (x2 - x1) * (y0 - y1) >= zero) : 0;
+			if (cull && GLPbo::fixed_point)
+			{
+				// SetupFrontFace() culls triangles in fixed point range on their snapped vertices
+				int fixed = SIMD::Bits((xmin > range0) & (xmax < range) & (ymin > range0) & (ymax < range));
+				if (fixed)
+				{
+					back = (back & ~fixed) | (BackFixed(x0, y0, x1, y1, x2, y2) & fixed);
+				}
+			}
+
+			for (int lane = 0; lane < SIMD::width && k + lane < n; ++lane)
+			{
+				int i = k + lane;
+				bool clip = clip_any[i] || ((overflow >> lane) & 1);
+				if (clip_all[i] || (!clip && ((outside | back) >> lane) & 1))
+				{
+					continue;
+				}
+				face[count] = first + i;
+				clipped[count] = clip;
+				kept.x0[count] = gathered.x0[i], kept.y0[count] = gathered.y0[i], kept.z0[count] = gathered.z0[i];
+				kept.x1[count] = gathered.x1[i], kept.y1[count] = gathered.y1[i], kept.z1[count] = gathered.z1[i];
+				kept.x2[count] = gathered.x2[i], kept.y2[count] = gathered.y2[i], kept.z2[count] = gathered.z2[i];
+				++count;
+			}
+		}
+		return count;
+	}
+}
+
+/*!
+ * @brief ___Clusters___
+ * *********************
+ * Meshlet culling ahead of the vertex stage of draw_elements(). The
+ * meshlets that may have visible triangles are kept as runs of
+ * consecutive triangles, and runs of the vertices those use, so culled
+ * meshlets cost neither vertex nor triangle work.
+*/
+namespace Clusters
+{
+	/*!
+	 * @brief ___Clusters::Run___
+	 * *******************************
+	 * [first, first + count) of a model's triangles or vertices.
+	*/
+	struct Run
+	{
+		size_t	first, count;
+	};
+
+	std::vector<Run>	triangles;		/*!< kept this draw, in order */
+	std::vector<Run>	vertices;		/*!< used by kept triangles, may overlap */
+
+	/*!
+	 * @brief ___Clusters::Add___
+	 * *******************************
+	 * Appends a run, merged into the last one where they touch or overlap.
+	*/
+	void Add(std::vector<Run>& runs, size_t first, size_t count)
+	{
+		if (!runs.empty() && first <= runs.back().first + runs.back().count && first >= runs.back().first)
+		{
+			Run& last = runs.back();
+			last.count = std::max(last.first + last.count, first + count) - last.first;
+			return;
+		}
+		runs.push_back({ first, count });
+	}
+
+	/*!
+	 * @brief ___Clusters::Select___
+	 * *******************************
+	 * Fills triangles and vertices with the meshlets of a model that pass
+	 * culling, or with everything if the model has none or
+	 * GLPbo::cluster_culling is cleared.
+	 * A meshlet is outside the view volume if its bounding sphere is
+	 * entirely behind one of the planes of -w <= x, y, z <= w, taken into
+	 * model space. Its triangles all face away if the eye is behind all
+	 * their planes: with E the eye in homogeneous model coordinates, mvp
+	 * times E being (0, 0, -1, 0), a triangle is back facing exactly when
+	 * det(mvp) * dot(n, E.xyz - p * E.w) >= 0 for its normal n and any of
+	 * its points p, which covers orthographic projections, with E.w = 0, as
+	 * well as perspective ones. Over the bounding sphere and the normal
+	 * cone, the dot product is at least |U| cos(angle(axis, U) + half
+	 * angle) - |E.w| radius, with U its value at the center.
+	*/
+	void Select(GLPbo::Model const& model, glm::mat4 const& mvp)
+	{
+		triangles.clear();
+		vertices.clear();
+		float det = glm::determinant(mvp);
+		if (!GLPbo::cluster_culling || model.meshlets.empty() || det == 0.f)
+		{
+			triangles.push_back({ 0, model.triangle_cnt() });
+			vertices.push_back({ 0, model.pm.size() });
+			return;
+		}
+
+		glm::vec4 planes[6];
+		glm::vec4 row[4];
+		for (int r = 0; r < 4; ++r)
+		{
+			row[r] = glm::vec4(mvp[0][r], mvp[1][r], mvp[2][r], mvp[3][r]);
+		}
+		for (int r = 0; r < 3; ++r)
+		{
+			planes[r * 2] = row[3] + row[r];
+			planes[r * 2 + 1] = row[3] - row[r];
+		}
+		float plane_len[6];
+		for (int i = 0; i < 6; ++i)
+		{
+			plane_len[i] = glm::length(glm::vec3(planes[i]));
+		}
+		glm::vec4 eye = glm::inverse(mvp) * glm::vec4(0.f, 0.f, -1.f, 0.f);
+		float sign = det > 0.f ? 1.f : -1.f;
+		bool backs = GLPbo::backface_culling;
+
+		for (GLPbo::Meshlet const& m : model.meshlets)
+		{
+			bool outside = false;
+			for (int i = 0; i < 6 && !outside; ++i)
+			{
+				outside = glm::dot(glm::vec3(planes[i]), m.center) + planes[i].w < -m.radius * plane_len[i];
+			}
+			if (outside)
+			{
+				continue;
+			}
+			if (backs && m.cone_cos > 0.f)
+			{
+				glm::vec3 u = sign * (glm::vec3(eye) - m.center * eye.w);
+				float along = glm::dot(m.cone_axis, u);
+				float across = std::sqrt(std::max(0.f, glm::dot(u, u) - along * along));
+				if (along * m.cone_cos - across * m.cone_sin > std::abs(eye.w) * m.radius)
+				{
+					continue;
+				}
+			}
+			Add(triangles, m.first_triangle, m.triangle_cnt);
+			Add(vertices, m.first_vertex, m.vertex_cnt);
+		}
+	}
+}
+
+/*!
+ * @brief ___init_rasterizer___
+ * ****************************************************************************************************
+ * Sets the buffer dimensions and allocates everything the emulator needs
+ * to draw a w x h image: screen tiles and their workers, the depth buffer
+ * and its hierarchical z bounds. The clear color is set to white.
+ * ****************************************************************************************************
+ * @param w, h
+ * : Dimensions of the render targets that will be drawn to.
+ * ****************************************************************************************************
+*/
+void GLPbo::init_rasterizer(GLsizei w, GLsizei h)
+{
+	width = w;
+	height = h;
+	pixel_cnt = width * height;
+	byte_cnt = pixel_cnt * sizeof(Color);
+
+	// screen tiles and workers for the tiled rasterizer
+	Tiles::Init();
+
+	// color buffer of the block layout, and the depth buffer, big enough
+	// for either layout, and its hierarchical z bounds
+	Blocks::Init();
+	depth_buffer.assign(Blocks::count, clear_depth);
+	HiZ::Init();
+
+	set_clear_color(255, 255, 255);
+}
+
+/*!
+ * @brief ___cleanup_rasterizer___
+ * ****************************************************************************************************
+ * Joins the rasterizer workers.
+ * ****************************************************************************************************
+*/
+void GLPbo::cleanup_rasterizer()
+{
+	Tiles::workers.reset();
+}
+
+/*!
+ * @brief ___rasterizer_workers___
+ * ****************************************************************************************************
+ * The pool the tiles are rasterized on, so loading a scene can use the
+ * same threads rather than spawn its own.
+ * ****************************************************************************************************
+*/
+ThreadPool* GLPbo::rasterizer_workers()
+{
+	return Tiles::workers.get();
+}
+
+/*!
+ * @brief ___render_scene___
+ * ****************************************************************************************************
+ * Draws one frame of the current scene into a render target: maps it,
+ * clears it, draws the current model and resolves the tiles before
+ * unmapping it again. With dirty_tiles, only the tiles that changed are
+ * cleared and presented.
+ * ****************************************************************************************************
+ * @param target
+ * : width x height render target to draw into.
+ * ****************************************************************************************************
+*/
+void GLPbo::render_scene(RenderTarget& target)
+{
+	ptr_to_pbo = target.Map();
+
+	// clear color buffer, only the tiles earlier frames drew into if they
+	// are tracked and kept the same clear color, and depth buffer if it is
+	// used
+	target.SetClearColor(clear_clr);
+	Tiles::stale = dirty_tiles ? &target.GetStale() : nullptr;
+	clear_color_buffer();
+	std::fill(drawn_tiles.begin(), drawn_tiles.end(), 0);
+	if (depth_test)
+	{
+		clear_depth_buffer();
+	}
+
+	// draws scene
+	Scene::DrawScene();
+
+	// rasterize whatever was binned, if tiled, and fill the tiles that are
+	// still cleared
+	resolve_tiles();
+	Tiles::stale = nullptr;
+
+	if (dirty_tiles)
+	{
+		target.SetDrawn(drawn_tiles);
+	}
+	target.Unmap();
+	ptr_to_pbo = nullptr;
+}
+
+
+/*!
+ * @brief part 1,
+ * First overload of function set_clear_color. Emulates behavior of GL command
+ * glClearColor().
+ * @param color : 
+ * value to set static data memberr GLPbo::clear_clr to.
+*/
+void GLPbo::set_clear_color(GLPbo::Color color)
+{
+	GLPbo::clear_clr = color;
+}
+
+/*!
+ * @brief part 1,
+ * Second overload of function set_clear_color. Emulates behavior of GL command
+ * glClearColor().
+ * @param r : red channel
+ * @param g : green channel
+ * @param b : blue channel
+ * @param a : alpha channel
+*/
+void GLPbo::set_clear_color(GLubyte r, GLubyte g, GLubyte b, GLubyte a)
+{
+	GLPbo::clear_clr = { r,g,b,a };
+}
+
+/*!
+ * @brief part 2,
+ * This function emulates GL command glClear(GL_COLOR_BUFFER_BIT) by using
+ * GLPbo::ptr_to_pbo to fill the PBO (that GLPbo::ptr_to_pbo points to) with
+ * the RGBA value in GLPbo::clear_clr.
+ * 
+ * GLPbo::ptr_to_pbo is of type Color* which is an array of Color objects.
+ * Fill the entire array with GLPbo::clear_clr using std::fill/std::fill_n/
+ * std::memcpy.
+ * With GLPbo::block_layout the block layout color buffer is cleared instead,
+ * resolve_tiles() copies it to the PBO. With GLPbo::fast_clear the tiles
+ * are only flagged as cleared, otherwise they are filled with non-temporal
+ * stores, only the stale ones if render_scene() tracks them.
+*/
+void GLPbo::clear_color_buffer()
+{
+	if (fast_clear)
+	{
+		Tiles::Defer();
+		return;
+	}
+	if (block_layout)
+	{
+		StreamFill(Blocks::color, Blocks::count, clear_clr);
+	}
+	else if (Tiles::stale)
+	{
+		Tiles::Clear(*Tiles::stale);
+	}
+	else
+	{
+		StreamFill(ptr_to_pbo, pixel_cnt, clear_clr);
+	}
+	SIMD::Fence();
+}
+
+/*!
+ * @brief ___clear_depth_buffer___
+ * ****************************************************************************************************
+ * Emulates glClear(GL_DEPTH_BUFFER_BIT) by filling the depth buffer with
+ * GLPbo::clear_depth. Every block's hierarchical z bounds collapse to the
+ * same value.
+ * ****************************************************************************************************
+*/
+void GLPbo::clear_depth_buffer()
+{
+	std::fill(depth_buffer.begin(), depth_buffer.end(), clear_depth);
+	HiZ::Clear(clear_depth);
+}
+
+/* ____________________________________________________________________________________________________
+*									TUTORIAL 7 FUNCTIONS
+*  ____________________________________________________________________________________________________
+*/
+
+/*!
+ * @brief ___Model::set_triangles___
+ * ****************************************************************************************************
+ * Sets the triangle indices of a model whose positions are loaded. Models
+ * with up to 65536 vertices keep 16-bit indices, which halves what the
+ * index loops read, larger ones keep the 32-bit indices as they are.
+ * ****************************************************************************************************
+ * @param indices
+ * : Triangle indices into pm, emptied.
+ * ****************************************************************************************************
+*/
+void GLPbo::Model::set_triangles(std::vector<GLuint>&& indices)
+{
+	tri.clear();
+	tri32.clear();
+	if (pm.size() > std::numeric_limits<unsigned short>::max() + size_t(1))
+	{
+		tri32 = std::move(indices);
+		return;
+	}
+	tri.assign(indices.begin(), indices.end());
+	indices.clear();
+}
+
+/*!
+ * @brief ___transform_vertices___
+ * ****************************************************************************************************
+ * Vertex stage: transforms every vertex of a specified model by a model
+ * view projection matrix, classifies it against the near and far planes,
+ * then does the perspective divide and viewport transform. z in [-1, 1]
+ * is mapped to depth in [0, 1] like glDepthRange(0, 1), nearer vertices
+ * get smaller depths.
+ * ****************************************************************************************************
+ * @param model 
+ * : Model to transform.
+ * @param mvp
+ * : Model view projection matrix.
+ * ****************************************************************************************************
+*/
+void GLPbo::transform_vertices(Model& model, glm::mat4 const& mvp)
+{
+	transform_vertices(model, mvp, 0, model.pm.size());
+}
+
+/*!
+ * @brief ___transform_vertices___
+ * ****************************************************************************************************
+ * Vertex stage for a range of a model's vertices, widened to whole SIMD
+ * registers. The stage buffers are sized for the whole model, and the
+ * other vertices keep whatever they held.
+ * ****************************************************************************************************
+ * @param model
+ * : Model to transform.
+ * @param mvp
+ * : Model view projection matrix.
+ * @param first, count
+ * : Vertices to transform.
+ * ****************************************************************************************************
+*/
+void GLPbo::transform_vertices(Model& model, glm::mat4 const& mvp, size_t first, size_t count)
+{
+	// padding the arrays to whole registers leaves no remainder loop, the
+	// padding vertices are transformed too but never referenced
+	size_t padded = (model.pm.size() + SIMD::width - 1) / SIMD::width * SIMD::width;
+	if (model.xc.size() != padded)
+	{
+		for (std::vector<float>* v : { &model.xc, &model.yc, &model.zc, &model.wc, &model.xd, &model.yd, &model.zd, &model.qd })
+		{
+			v->assign(padded, 0.f);
+		}
+		model.clip.assign(padded, 0);
+	}
+	if (model.px.size() != padded)
+	{
+		for (std::vector<float>* v : { &model.px, &model.py, &model.pz })
+		{
+			v->assign(padded, 0.f);
+		}
+		for (size_t i = 0; i < model.pm.size(); ++i)
+		{
+			model.px[i] = model.pm[i].x;
+			model.py[i] = model.pm[i].y;
+			model.pz[i] = model.pm[i].z;
+		}
+	}
+
+	SIMD::Float m[4][4];
+	for (int col = 0; col < 4; ++col)
+	{
+		for (int row = 0; row < 4; ++row)
+		{
+			m[col][row] = SIMD::Set1(mvp[col][row]);
+		}
+	}
+	SIMD::Float one = SIMD::Set1(1.f), half = SIMD::Set1(0.5f), zero = SIMD::Set1(0.f);
+	SIMD::Float w_scale = SIMD::Set1(static_cast<float>(width)), h_scale = SIMD::Set1(static_cast<float>(height));
+
+	size_t begin = first / SIMD::width * SIMD::width;
+	size_t end = std::min(padded, (first + count + SIMD::width - 1) / SIMD::width * SIMD::width);
+	for (size_t i = begin; i < end; i += SIMD::width)
+	{
+		SIMD::Float x = SIMD::Load(&model.px[i]), y = SIMD::Load(&model.py[i]), z = SIMD::Load(&model.pz[i]);
+		SIMD::Float xc = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0];
+		SIMD::Float yc = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1];
+		SIMD::Float zc = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2];
+		SIMD::Float wc = m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3];
+		SIMD::Store(&model.xc[i], xc);
+		SIMD::Store(&model.yc[i], yc);
+		SIMD::Store(&model.zc[i], zc);
+		SIMD::Store(&model.wc[i], wc);
+
+		int near_bits = SIMD::Bits(zc < zero - wc), far_bits = SIMD::Bits(zc > wc);
+		for (int lane = 0; lane < SIMD::width; ++lane)
+		{
+			model.clip[i + lane] = static_cast<unsigned char>(((near_bits >> lane) & 1) * clip_near | ((far_bits >> lane) & 1) * clip_far);
+		}
+
+		// same operations as Clip::ToWindow()
+		SIMD::Float inv_w = one / wc;
+		SIMD::Store(&model.xd[i], (xc * inv_w + one) * half * w_scale);
+		SIMD::Store(&model.yd[i], (yc * inv_w + one) * half * h_scale);
+		SIMD::Store(&model.zd[i], (zc * inv_w + one) * half);
+		SIMD::Store(&model.qd[i], inv_w);
+	}
+}
+
+/*!
+ * @brief ___set_pixel___
+ * ****************************************************************************************************
+ * Sets a color into the specified location in the pbo and flags its tile
+ * as drawn, filling it first if it is still flagged as cleared. Does no
+ * scissoring, everything that calls it is clipped to the viewport
+ * beforehand.
+ * ****************************************************************************************************
+ * @param x 
+ * : x-coordinate in [0, width).
+ * @param y 
+ * : y-coordinate in [0, height).
+ * @param draw_clr
+ * : Color to set the pixel to.
+ * ****************************************************************************************************
+*/
+void GLPbo::set_pixel(GLint x, GLint y, GLPbo::Color draw_clr)
+{
+	size_t tile = static_cast<size_t>(y / tile_size) * Tiles::cols + x / tile_size;
+	if (Tiles::cleared[tile])
+	{
+		Tiles::Fill(tile);
+	}
+	drawn_tiles[tile] = 1;
+	*Blocks::ColorAt(x, y) = draw_clr;
+}
+
+/*!
+ * @brief ___BresenhamSpan___
+ * ****************************************************************************************************
+ * State of a Bresenham line at its first pixel inside the viewport, and how
+ * many of its pixels from there on are inside.
+ * ****************************************************************************************************
+*/
+struct BresenhamSpan
+{
+	GLint	major, minor;	/*!< coordinates of the first pixel along the major and minor axis */
+	int		d;				/*!< decision variable at that pixel */
+	int		count;			/*!< pixels left to draw, including that one */
+};
+
+/*!
+ * @brief ___ClipBresenham___
+ * ****************************************************************************************************
+ * Clips a Bresenham line to the viewport without stepping through the
+ * pixels outside of it. With d = 2 * dmin - dmaj at pixel 0, the decision
+ * variable stays in (2 * dmin - 2 * dmaj, 2 * dmin], so pixel j of the line
+ * lies at
+ *   major(j) = major0 + j * major_step
+ *   minor(j) = minor0 + k(j) * minor_step, k(j) = (2 * j * dmin + dmaj - 1) / (2 * dmaj)
+ * Both never decrease with j, so the pixels inside the viewport are one
+ * range of j that can be solved for directly.
+ * ****************************************************************************************************
+ * @param major0, major_step, major_size
+ * : Start, direction (+1 or -1) and viewport size along the major axis.
+ * @param minor0, minor_step, minor_size
+ * : Same along the minor axis.
+ * @param dmaj, dmin
+ * : Absolute deltas along the major and minor axis, dmin <= dmaj.
+ * @param span
+ * : Filled with the state at the first pixel inside the viewport.
+ * @return bool
+ * : False if no pixel of the line is inside the viewport.
+ * ****************************************************************************************************
+*/
+bool ClipBresenham(GLint major0, int major_step, GLint major_size, GLint minor0, int minor_step, GLint minor_size,
+	long long dmaj, long long dmin, BresenhamSpan& span)
+{
+	// range [lo, hi] of t for which start + step * t is in [0, size)
+	auto axis_range = [](long long start, int step, long long size, long long& lo, long long& hi)
+	{
+		lo = step > 0 ? -start : start - (size - 1);
+		hi = step > 0 ? size - 1 - start : start;
+	};
+	// first pixel j whose k(j) >= k
+	long long const never = std::numeric_limits<long long>::max();
+	auto first_step = [=](long long k) -> long long
+	{
+		if (k <= 0)
+		{
+			return 0;
+		}
+		if (dmin == 0)
+		{
+			return never;
+		}
+		long long num = 2 * k * dmaj - dmaj + 1, den = 2 * dmin;
+		return (num + den - 1) / den;
+	};
+
+	long long first, last, klo, khi;
+	axis_range(major0, major_step, major_size, first, last);
+	axis_range(minor0, minor_step, minor_size, klo, khi);
+	first = std::max({ first, 0LL, first_step(klo) });
+	last = std::min({ last, std::max(dmaj, 1LL) - 1, first_step(khi + 1) - 1 });
+	if (first > last)
+	{
+		return false;
+	}
+
+	long long k = first > 0 ? (2 * first * dmin + dmaj - 1) / (2 * dmaj) : 0;
+	span.major = static_cast<GLint>(major0 + first * major_step);
+	span.minor = static_cast<GLint>(minor0 + k * minor_step);
+	span.d = static_cast<int>(2 * dmin - dmaj + 2 * first * dmin - 2 * k * dmaj);
+	span.count = static_cast<int>(last - first + 1);
+	return true;
+}
+
+/*!
+ * @brief ___line_bresenham_octant1256___
+ * ****************************************************************************************************
+ *	: Bresenham line drawing algorithm for if the line falls within octant 1256
+ * ****************************************************************************************************
+ * @param x1 
+ *	: Start x
+ * @param y1 
+ *	: Start y
+ * @param x2
+ *	: End x
+ * @param y2
+ *	: End y
+ * @param draw_clr
+ *	: Color of the line to be drawn
+ * ****************************************************************************************************
+*/
+void line_bresenham_octant1256(GLint x1, GLint y1, GLint x2, GLint y2, GLPbo::Color draw_clr)
+{
+	int dx = x2 - x1, dy = y2 - y1;
+	int xstep = (dx < 0) ? -1 : 1;
+	int ystep = (dy < 0) ? -1 : 1;
+	dx = (dx < 0) ? -dx : dx;
+	dy = (dy < 0) ? -dy : dy;
+	int dmin = 2 * dx, dmaj = 2 * dx - 2 * dy;
+
+	// start at the first pixel inside the viewport
+	BresenhamSpan span;
+	if (!ClipBresenham(y1, ystep, GLPbo::height, x1, xstep, GLPbo::width, dy, dx, span))
+	{
+		return;
+	}
+	x1 = span.minor;
+	y1 = span.major;
+	int d = span.d;
+	GLPbo::set_pixel(x1, y1, draw_clr);
+	while (--span.count > 0)
+	{
+		x1 += (d > 0) ? xstep : 0;
+		d += (d > 0) ? dmaj : dmin;
+		y1 += ystep;
+		GLPbo::set_pixel(x1, y1, draw_clr);
+	}
+}
+
+/*!
+ * @brief ___ line_bresenham_octant0347___
+ * ****************************************************************************************************
+ *	Bresenham line drawing algorithm for if 
+ *  the line falls within octant 0347
+ * ****************************************************************************************************
+ * @param x1
+ *	: Start x
+ * @param y1
+ *	: Start y
+ * @param x2
+ *	: End x
+ * @param y2
+ *	: End y
+ * @param draw_clr
+ *	: Color of the line to be drawn
+ * ****************************************************************************************************
+*/
+void line_bresenham_octant0347(GLint x1, GLint y1, GLint x2, GLint y2, GLPbo::Color draw_clr)
+{
+	int dx = x2 - x1, dy = y2 - y1;
+	int xstep = (dx < 0) ? -1 : 1;
+	int ystep = (dy < 0) ? -1 : 1;
+	dx = (dx < 0) ? -dx : dx;
+	dy = (dy < 0) ? -dy : dy;
+	int dmin = 2 * dy, dmaj = 2 * dy - 2 * dx;
+
+	// start at the first pixel inside the viewport
+	BresenhamSpan span;
+	if (!ClipBresenham(x1, xstep, GLPbo::width, y1, ystep, GLPbo::height, dx, dy, span))
+	{
+		return;
+	}
+	x1 = span.major;
+	y1 = span.minor;
+	int d = span.d;
+	GLPbo::set_pixel(x1, y1, draw_clr);
+	while (--span.count > 0)
+	{
+		y1 += (d > 0) ? ystep : 0;
+		d += (d > 0) ? dmaj : dmin;
+		x1 += xstep;
+		GLPbo::set_pixel(x1, y1, draw_clr);
+	}
+}
+
+/*!
+ * @brief ___render_linebresenham___
+ * ****************************************************************************************************
+ * : Renders a line between 2 points using the bresenham line drawing algorithm
+ * ****************************************************************************************************
+ * @param px0 
+ * : Start x
+ * @param py0
+ * : Start y
+ * @param px1
+ * : End x
+ * @param py1
+ * : End y
+ * @param draw_clr
+ * : Color of the line to be drawn
+ * ****************************************************************************************************
+*/
+void GLPbo::render_linebresenham(GLint px0, GLint py0, GLint px1, GLint py1, GLPbo::Color draw_clr)
+{
+	// check if line to be drawn falls within 1256 or 0347
+	// i.e. is rise <= run, 0347, else 1256
+	GLint rise = abs(py1 - py0);
+	GLint run = abs(px1 - px0);
+	if (rise <= run)
+	{
+		line_bresenham_octant0347(px0, py0, px1, py1, draw_clr);
+	}
+	else
+	{
+		line_bresenham_octant1256(px0, py0, px1, py1, draw_clr);
+	}
+}
+
+/*!
+ * @brief ___RenderPolygonWireframe___
+ * ****************************************************************************************************
+ * Backface culls a convex polygon in window coordinates and draws its
+ * outline. Lines clip themselves to the viewport, the polygon is only
+ * clipped to the guard band to keep its vertices in int range.
+ * ****************************************************************************************************
+ * @param poly, n
+ * : Polygon with n vertices, n <= 3 + 2.
+ * @param clr
+ * : Color to render the edges.
+ * @return bool
+ * : If the polygon was rendered. I.e. not backface-culled or off screen.
+ * ****************************************************************************************************
+*/
+static bool RenderPolygonWireframe(Clip::Vertex const* poly, int n, const GLPbo::Color& clr)
+{
+	// backface culling, on the whole polygon once clipped to near or far
+	float area = 0.f;
+	if (n == 3)
+	{
+		glm::vec3 vec1 = poly[0].p - poly[1].p;
+		glm::vec3 vec2 = poly[2].p - poly[1].p;
+		area = vec2.x * vec1.y - vec1.x * vec2.y;
+	}
+	else
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			glm::vec3 const& a = poly[i].p;
+			glm::vec3 const& b = poly[i + 1 < n ? i + 1 : 0].p;
+			area += a.x * b.y - b.x * a.y;
+		}
+	}
+	if (area <= 0.f)
+	{
+		return false;
+	}
+
+	Clip::Vertex clipped[Clip::max_vertices];
+	std::copy(poly, poly + n, clipped);
+	switch (Clip::Classify(clipped, n))
+	{
+	case Clip::Result::Outside:
+		return false;
+	case Clip::Result::Overflow:
+		n = Clip::Polygon(clipped, n);
+		break;
+	default:
+		break;
+	}
+	if (n < 3)
+	{
+		return false;
+	}
+
+	// the closing edge goes from the first vertex too, so an unclipped
+	// triangle draws the same lines in the same direction as always
+	for (int i = 0; i < n; ++i)
+	{
+		glm::vec3 const& a = clipped[i + 1 < n ? i : 0].p;
+		glm::vec3 const& b = clipped[i + 1 < n ? i + 1 : i].p;
+		GLPbo::render_linebresenham((GLint)a.x, (GLint)a.y, (GLint)b.x, (GLint)b.y, clr);
+	}
+	return true;
+}
+
+/*!
+ * @brief ___render_triangle_wireframe___
+ * ****************************************************************************************************
+ * Renders a triangle in wireframe mode using bresenham line drawing algorithms.
+ * ****************************************************************************************************
+ * @param p0 
+ * : Vertex 1 of the triangle.
+ * @param p1 
+ * : Vertex 2 of the triangle.
+ * @param p2 
+ * : Vertex 3 of the triangle.
+ * @param clr 
+ * : Color to render the triangle edges.
+ * @return bool
+ * : If triangle was successfully rendered. I.e. not backface-culled.
+ * ****************************************************************************************************
+*/
+bool GLPbo::render_triangle_wireframe(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, const GLPbo::Color& clr)
+{
+	Clip::Vertex poly[3] = { { p0 }, { p1 }, { p2 } };
+	return RenderPolygonWireframe(poly, 3, clr);
+}
+
+/*!
+ * @brief ___render_triangle_wireframe___
+ * ****************************************************************************************************
+ * Renders the triangle (i0, i1, i2) of a transformed model in wireframe
+ * mode, clipped to the near and far planes.
+ * ****************************************************************************************************
+*/
+bool GLPbo::render_triangle_wireframe(Model const& model, GLuint i0, GLuint i1, GLuint i2, const GLPbo::Color& clr)
+{
+	return Clip::Assemble(model, i0, i1, i2, nullptr, 0, [&clr](Clip::Vertex const* poly, int n)
+	{
+		return RenderPolygonWireframe(poly, n, clr);
+	});
+}
+
+/*!
+ * @brief ___CalculateEvaluation___
+ * ****************************************************************************************************
+ * Calculated the evaluation value of a window coordinate to see if its
+ * inside or outside an edge.
+ * ****************************************************************************************************
+ * @param edge
+ * : Edge to check against.
+ * @param x 
+ * : x-coordinate.
+ * @param y 
+ * : y-coordinate.
+ * @return float
+ * : The evaluation value.
+ * ****************************************************************************************************
+*/
+float CalculateEvaluation(const glm::vec3& edge, const float& x, const float& y)
+{
+	return edge.x * x + edge.y * y + edge.z;
+}
+
+/*!
+ * @brief ___TopLeft___
+ * ****************************************************************************************************
+ * Precalculates top left for a given edge.
+ * ****************************************************************************************************
+ * @param edge 
+ * : Edge that top left is being calculated for.
+ * @return bool
+ * : If the edge is a top left edge.
+ * ****************************************************************************************************
+*/
+bool TopLeft(const glm::vec3& edge)
+{
+	if (edge.x > 0.f)	return true;	// on left edge
+	if (edge.x < 0.f)	return false;	// on right edge
+	if (edge.y < 0.f)	return true;	// on top edge
+	return false;						// on bottom edge
+}
+
+/*!
+ * @brief ___PointInEdgeTopLeft___
+ * ****************************************************************************************************
+ * reference link: https://drive.google.com/file/d/1BvbTMFUUp_SUjtVJZfi44NDx4oRa-7d4/view?usp=sharing.
+ * Returns if an evaluated pixel belongs in the edge.
+ * ****************************************************************************************************
+ * @param edge 
+ * : Edge to check with
+ * @param eval 
+ * : Precalculated evaluation
+ * @return 
+ * : If evaluation falls within the edge
+ * ****************************************************************************************************
+*/
+bool PointInEdgeTopLeft(const glm::vec3& edge, const float& eval)
+{
+	if (eval > 0.f)		return true;	// completely inside edge
+	if (eval < 0.f)		return false;	// completely outside edge
+	if (edge.x > 0.f)	return true;	// on left edge
+	if (edge.x < 0.f)	return false;	// on right edge
+	if (edge.y < 0.f)	return true;	// on top edge
+	return false;						// on bottom edge
+}
+
+/*!
+ * @brief ___PointInEdgeTopLeftOptimized___
+ * ****************************************************************************************************
+ * Optimized check with precalculated top left of edge.
+ * ****************************************************************************************************
+ * @param eval 
+ * : Incremented evaluation.
+ * @param tl
+ * : Precalculated topleft.
+ * @return bool
+ * : If evaluated point falls within edge.
+ * ****************************************************************************************************
+*/
+bool PointInEdgeTopLeftOptimized(const float& eval, bool tl)
+{
+	return (eval > 0.f || (eval == 0.f && tl)) ? true : false;
+}
+
+
+/*!
+ * @brief ___SetupDepthPlane___
+ * ****************************************************************************************************
+ * Plane through the depths of a triangle's vertices, in pixel coordinates.
+ * Like the edge equations, a pixel's depth is then only a function of its
+ * own coordinates.
+ * ****************************************************************************************************
+*/
+void SetupDepthPlane(GLPbo::TriangleSetup& setup, glm::dvec3 const& q0, glm::dvec3 const& q1, glm::dvec3 const& q2)
+{
+	glm::dvec3 u = q1 - q0, v = q2 - q0;
+	double double_area = u.x * v.y - v.x * u.y;
+	double dzdx = (u.z * v.y - v.z * u.y) / double_area;
+	double dzdy = (u.x * v.z - v.x * u.z) / double_area;
+	setup.z_plane = glm::vec3(dzdx, dzdy, q0.z - dzdx * q0.x - dzdy * q0.y);
+	setup.zmin = static_cast<GLfloat>(std::min({ q0.z, q1.z, q2.z }));
+	setup.zmax = static_cast<GLfloat>(std::max({ q0.z, q1.z, q2.z }));
+}
+
+/*!
+ * @brief ___SnapFixed___
+ * ****************************************************************************************************
+ * Rounds a coordinate to the nearest 1/16 pixel, halfway cases away from
+ * zero like llround() but inline. v * 16 has at most 24 significant bits,
+ * so adding 0.5 to it in double is exact and truncating rounds correctly.
+ * ****************************************************************************************************
+*/
+inline long long SnapFixed(float v)
+{
+	double x = static_cast<double>(v) * (1 << GLPbo::subpixel_bits);
+	return static_cast<long long>(x + std::copysign(0.5, x));
+}
+
+/*!
+ * @brief ___SetupTriangleFixed___
+ * ****************************************************************************************************
+ * Fixed point counterpart of the float part of SetupFrontFace().
+ * Vertices are snapped to 1/16 pixel and the edge equations are computed
+ * with 64-bit integers, so they are exact: two triangles sharing an edge
+ * evaluate it to exactly opposite values and the top left rule then gives
+ * every pixel center on the edge to exactly one of them.
+ * ****************************************************************************************************
+ * @return bool
+ * : False if the snapped triangle is backfacing or degenerate.
+ * ****************************************************************************************************
+*/
+bool SetupTriangleFixed(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, GLPbo::TriangleSetup& setup)
+{
+	constexpr double one = 1 << GLPbo::subpixel_bits;
+	long long x0 = SnapFixed(p0.x), y0 = SnapFixed(p0.y);
+	long long x1 = SnapFixed(p1.x), y1 = SnapFixed(p1.y);
+	long long x2 = SnapFixed(p2.x), y2 = SnapFixed(p2.y);
+
+	// backface culling, snapping can also collapse a triangle to zero area
+	long long double_area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+	if (double_area <= 0)
+	{
+		return false;
+	}
+
+	// same edges as the float edge equations l0, l1, l2
+	setup.f0 = { y1 - y2, x2 - x1, x1 * y2 - x2 * y1 };
+	setup.f1 = { y2 - y0, x0 - x2, x2 * y0 - x0 * y2 };
+	setup.f2 = { y0 - y1, x1 - x0, x0 * y1 - x1 * y0 };
+
+	// TopLeft() on the integer gradients, without branches as edges of
+	// consecutive triangles face every which way
+	auto top_left = [](GLPbo::TriangleSetup::FixedEdge const& f) { return (f.a > 0) | ((f.a == 0) & (f.b < 0)); };
+	setup.l0_tl = top_left(setup.f0);
+	setup.l1_tl = top_left(setup.f1);
+	setup.l2_tl = top_left(setup.f2);
+
+	// compute aabb, shifts floor and the added fraction turns that into ceil
+	constexpr long long fraction = (1 << GLPbo::subpixel_bits) - 1;
+	setup.xmin = static_cast<GLint>(std::min(std::min(x0, x1), x2) >> GLPbo::subpixel_bits);
+	setup.xmax = static_cast<GLint>((std::max(std::max(x0, x1), x2) + fraction) >> GLPbo::subpixel_bits);
+	setup.ymin = static_cast<GLint>(std::min(std::min(y0, y1), y2) >> GLPbo::subpixel_bits);
+	setup.ymax = static_cast<GLint>((std::max(std::max(y0, y1), y2) + fraction) >> GLPbo::subpixel_bits);
+
+	SetupDepthPlane(setup, { x0 / one, y0 / one, p0.z }, { x1 / one, y1 / one, p1.z }, { x2 / one, y2 / one, p2.z });
+	return true;
+}
+
+/*!
+ * @brief ___SetupVaryingPlanesFixed___
+ * ****************************************************************************************************
+ * Varyings of fixed point triangles. The barycentric interpolation of each
+ * varying, and of 1 / w when setup.perspective is set, is folded into one
+ * plane equation, so a pixel's varyings only depend on its own coordinates.
+ * ****************************************************************************************************
+ * @param a0, a1, a2
+ * : count values to interpolate at each vertex.
+ * @param q
+ * : 1 / w at each vertex.
+ * ****************************************************************************************************
+*/
+void SetupVaryingPlanesFixed(GLPbo::TriangleSetup& setup, GLfloat const* a0, GLfloat const* a1, GLfloat const* a2, int count, glm::vec3 const& q)
+{
+	// edge values sum up to the double area everywhere, in particular at (0,0)
+	constexpr double one = 1 << GLPbo::subpixel_bits;
+	double inv_area = 1.0 / static_cast<double>(setup.f0.c + setup.f1.c + setup.f2.c);
+	glm::dvec3 ea(setup.f0.a * one, setup.f1.a * one, setup.f2.a * one);
+	glm::dvec3 eb(setup.f0.b * one, setup.f1.b * one, setup.f2.b * one);
+	glm::dvec3 ec(setup.f0.c, setup.f1.c, setup.f2.c);
+	auto plane = [&ea, &eb, &ec, inv_area](double d0, double d1, double d2, GLfloat& dx, GLfloat& dy, GLfloat& c)
+	{
+		d0 *= inv_area, d1 *= inv_area, d2 *= inv_area;
+		dx = static_cast<GLfloat>(d0 * ea.x + d1 * ea.y + d2 * ea.z);
+		dy = static_cast<GLfloat>(d0 * eb.x + d1 * eb.y + d2 * eb.z);
+		c = static_cast<GLfloat>(d0 * ec.x + d1 * ec.y + d2 * ec.z);
+	};
+	for (int i = 0; i < count; ++i)
+	{
+		plane(a0[i], a1[i], a2[i], setup.k0[i], setup.k1[i], setup.k2[i]);
+	}
+	if (setup.perspective)
+	{
+		plane(q.x, q.y, q.z, setup.q_k.x, setup.q_k.y, setup.q_k.z);
+	}
+}
+
+/*!
+ * @brief ___SetupFrontFace___
+ * ****************************************************************************************************
+ * Body of GLPbo::setup_triangle() once the winding is settled. Backface culls
+ * the triangle and computes its edge equations, depth plane and aabb, in
+ * fixed point when GLPbo::fixed_point is set and the triangle is in range.
+ * ****************************************************************************************************
+ * @return bool
+ * : False if the triangle was backface-culled.
+ * ****************************************************************************************************
+*/
+bool SetupFrontFace(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, GLPbo::TriangleSetup& setup)
+{
+	// fixed point only for triangles whose per block edge values fit in int32
+	auto in_range = [](glm::vec3 const& p) { return std::abs(p.x) < GLPbo::fixed_max_coord && std::abs(p.y) < GLPbo::fixed_max_coord; };
+	setup.fixed = GLPbo::fixed_point && in_range(p0) && in_range(p1) && in_range(p2);
+	if (setup.fixed)
+	{
+		return SetupTriangleFixed(p0, p1, p2, setup);
+	}
+
+	// backface culling
+	glm::vec3 vec1 = p0 - p1;
+	glm::vec3 vec2 = p2 - p1;
+	if (vec1.x * vec2.y - vec2.x * vec1.y >= 0.0)
+	{
+		return false;
+	}
+
+	// compute edge equations
+	// reference slides: https://drive.google.com/file/d/1BvbTMFUUp_SUjtVJZfi44NDx4oRa-7d4/view?usp=sharing
+	setup.l0 = {	p1.y - p2.y,
+					p2.x - p1.x,
+					(p2.y - p1.y) * p1.x - (p2.x - p1.x) * p1.y };
+
+	setup.l1 = {	p2.y - p0.y,
+					p0.x - p2.x,
+					(p0.y - p2.y) * p2.x - (p0.x - p2.x) * p2.y };
+
+	setup.l2 = {	p0.y - p1.y,
+					p1.x - p0.x,
+					(p1.y - p0.y) * p0.x - (p1.x - p0.x) * p0.y };
+
+	setup.l0_tl = TopLeft(setup.l0);
+	setup.l1_tl = TopLeft(setup.l1);
+	setup.l2_tl = TopLeft(setup.l2);
+
+	// compute aabb
+	setup.xmin = (GLint)floor(std::min({ p0.x, p1.x, p2.x }));
+	setup.xmax = (GLint)ceil(std::max({ p0.x, p1.x, p2.x }));
+	setup.ymin = (GLint)floor(std::min({ p0.y, p1.y, p2.y }));
+	setup.ymax = (GLint)ceil(std::max({ p0.y, p1.y, p2.y }));
+
+	SetupDepthPlane(setup, p0, p1, p2);
+	return true;
+}
+
+/*!
+ * @brief ___setup_triangle___
+ * ****************************************************************************************************
+ * Backface culls a triangle and computes its edge equations, depth plane
+ * and aabb, in fixed point when GLPbo::fixed_point is set and the triangle
+ * is in range. With GLPbo::backface_culling cleared, a back face is set up
+ * as (p0, p2, p1) instead, which covers the same pixels as a front face.
+ * The aabb is clamped to the viewport, which is all the scissoring the
+ * rasterizer does; the clip stage keeps the vertices in the guard band.
+ * The color fields of setup are left for the caller to fill in.
+ * ****************************************************************************************************
+ * @param p0 
+ * : Vertex 1 of the triangle.
+ * @param p1 
+ * : Vertex 2 of the triangle.
+ * @param p2
+ * : Vertex 3 of the triangle.
+ * @param setup
+ * : Filled with the triangle's setup data.
+ * @return bool
+ * : False if the triangle was backface-culled or covers no part of the
+ * viewport.
+ * ****************************************************************************************************
+*/
+bool GLPbo::setup_triangle(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, TriangleSetup& setup)
+{
+	glm::vec3 vec1 = p0 - p1;
+	glm::vec3 vec2 = p2 - p1;
+	setup.flipped = !backface_culling && vec1.x * vec2.y - vec2.x * vec1.y >= 0.0;
+	if (!(setup.flipped ? SetupFrontFace(p0, p2, p1, setup) : SetupFrontFace(p0, p1, p2, setup)))
+	{
+		return false;
+	}
+
+	// scissor once per triangle, nothing past here checks the viewport again
+	setup.xmin = std::max(setup.xmin, 0);
+	setup.ymin = std::max(setup.ymin, 0);
+	setup.xmax = std::min(setup.xmax, width);
+	setup.ymax = std::min(setup.ymax, height);
+	return setup.xmin < setup.xmax && setup.ymin < setup.ymax;
+}
+
+/*!
+ * @brief ___Interpolate___
+ * ****************************************************************************************************
+ * Varyings of SIMD::width pixels given their three edge values. The
+ * constants were computed once per triangle by DrawTriangle(), so a pixel's
+ * varyings, like its edge values, only depend on its own coordinates and
+ * not on where the scan started.
+ * ****************************************************************************************************
+ * @param v
+ * : Filled with the first N varyings.
+ * @tparam N
+ * : Varyings of the shader, the loops unroll at compile time.
+ * ****************************************************************************************************
+*/
+template <int N>
+inline void Interpolate(GLPbo::TriangleSetup const& s, SIMD::Float eval0, SIMD::Float eval1, SIMD::Float eval2, SIMD::Float* v)
+{
+	// Barycentric interpolation reference: https://drive.google.com/file/d/1HYkDd45NZ3EfSm_ow9YMNMFxJFi8dqWY/view?usp=sharing
+	for (int i = 0; i < N; ++i)
+	{
+		v[i] = eval0 * SIMD::Set1(s.k0[i]) + eval1 * SIMD::Set1(s.k1[i]) + eval2 * SIMD::Set1(s.k2[i]);
+	}
+	if (N > 0 && s.perspective)
+	{
+		// varyings over w and 1 / w are linear in screen space, their ratio is not
+		SIMD::Float w = SIMD::Set1(1.f) / (eval0 * SIMD::Set1(s.q_k.x) + eval1 * SIMD::Set1(s.q_k.y) + eval2 * SIMD::Set1(s.q_k.z));
+		for (int i = 0; i < N; ++i)
+		{
+			v[i] = v[i] * w;
+		}
+	}
+}
+
+/*!
+ * @brief ___InterpolateFixed___
+ * ****************************************************************************************************
+ * Fixed point counterpart of Interpolate(), from the varying planes of
+ * SetupVaryingPlanesFixed() instead of the edge values.
+ * ****************************************************************************************************
+ * @param px
+ * : Pixel center x of each lane.
+ * @param rows, q_row
+ * : Row part of each varying plane, k1 * py + k2, and of the 1 / w plane.
+ * ****************************************************************************************************
+*/
+template <int N>
+inline void InterpolateFixed(GLPbo::TriangleSetup const& s, SIMD::Float px, float const* rows, float q_row, SIMD::Float* v)
+{
+	for (int i = 0; i < N; ++i)
+	{
+		v[i] = SIMD::Set1(s.k0[i]) * px + SIMD::Set1(rows[i]);
+	}
+	if (N > 0 && s.perspective)
+	{
+		SIMD::Float w = SIMD::Set1(1.f) / (SIMD::Set1(s.q_k.x) * px + SIMD::Set1(q_row));
+		for (int i = 0; i < N; ++i)
+		{
+			v[i] = v[i] * w;
+		}
+	}
+}
+
+/*!
+ * @brief ___VaryingsAt___
+ * ****************************************************************************************************
+ * Varyings at pixel centers (px, py) of a triangle, evaluated with the
+ * same expressions as the span kernels of its rasterizer, float or fixed.
+ * ****************************************************************************************************
+*/
+template <int N>
+inline void VaryingsAt(GLPbo::TriangleSetup const& s, SIMD::Float px, float py, SIMD::Float* v)
+{
+	if (s.fixed)
+	{
+		float rows[N > 0 ? N : 1];
+		for (int i = 0; i < N; ++i)
+		{
+			rows[i] = s.k1[i] * py + s.k2[i];
+		}
+		InterpolateFixed<N>(s, px, rows, s.q_k.y * py + s.q_k.z, v);
+		return;
+	}
+	SIMD::Float eval0 = SIMD::Set1(s.l0.x) * px + SIMD::Set1(s.l0.y * py + s.l0.z);
+	SIMD::Float eval1 = SIMD::Set1(s.l1.x) * px + SIMD::Set1(s.l1.y * py + s.l1.z);
+	SIMD::Float eval2 = SIMD::Set1(s.l2.x) * px + SIMD::Set1(s.l2.y * py + s.l2.z);
+	Interpolate<N>(s, eval0, eval1, eval2, v);
+}
+
+/*!
+ * @brief ___QuadDerivatives___
+ * ****************************************************************************************************
+ * Screen space derivatives of the varyings of SIMD::width pixels, taken
+ * over the 2x2 quad each pixel belongs to like a GPU does: the differences
+ * between the quad's top left pixel and its right and lower neighbours.
+ * Quads start at even coordinates. The neighbours are evaluated from the
+ * plane equations whether or not the triangle covers them, like a GPU's
+ * helper pixels. So the derivatives only depend on the pixel's coordinates,
+ * not on the scan order or SIMD::width.
+ * ****************************************************************************************************
+ * @param px, py
+ * : Pixel centers.
+ * @param ddx, ddy
+ * : Filled with the derivatives of the first N varyings along x and y.
+ * ****************************************************************************************************
+*/
+template <int N>
+inline void QuadDerivatives(GLPbo::TriangleSetup const& s, SIMD::Float px, float py, SIMD::Float* ddx, SIMD::Float* ddy)
+{
+	SIMD::Float qx = SIMD::ToFloat(SIMD::Truncate(px) & SIMD::Set1(~1)) + SIMD::Set1(0.5f);
+	float qy = static_cast<float>(static_cast<GLint>(py) & ~1) + 0.5f;
+	SIMD::Float v00[N > 0 ? N : 1], v10[N > 0 ? N : 1], v01[N > 0 ? N : 1];
+	VaryingsAt<N>(s, qx, qy, v00);
+	VaryingsAt<N>(s, qx + SIMD::Set1(1.f), qy, v10);
+	VaryingsAt<N>(s, qx, qy + 1.f, v01);
+	for (int i = 0; i < N; ++i)
+	{
+		ddx[i] = v10[i] - v00[i];
+		ddy[i] = v01[i] - v00[i];
+	}
+}
+
+// varyings of SIMD::width pixels, followed by their derivatives for quads
+// shaders, zero length arrays are not allowed
+template <typename Shader>
+using Varyings = SIMD::Float[Shader::varyings > 0 ? Shader::varyings * (Shader::quads ? 3 : 1) : 1];
+
+/*!
+ * @brief ___Shade___
+ * ****************************************************************************************************
+ * Runs a shader's fragment function on SIMD::width pixels whose varyings
+ * were interpolated into v, after adding their derivatives if the shader
+ * takes them.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+inline SIMD::Int Shade(GLPbo::TriangleSetup const& s, Shader const& shader, SIMD::Float px, float py, SIMD::Float* v)
+{
+	if (Shader::quads)
+	{
+		QuadDerivatives<Shader::varyings>(s, px, py, v + Shader::varyings, v + 2 * Shader::varyings);
+	}
+	return shader.fragment(s, v);
+}
+
+/*!
+ * @brief ___RasterizeSpan___
+ * ****************************************************************************************************
+ * Scans pixels [x0,x1) of one row SIMD::width pixels at a time and writes
+ * the covered ones with a masked store, lanes past x1 are masked off too.
+ * Edge values are evaluated from the pixel coordinates instead of being
+ * accumulated from the start of the scan, so every pixel gets the same
+ * result no matter which rectangle (whole aabb or a single tile) it was
+ * scanned from, and the same result with any SIMD::width.
+ * ****************************************************************************************************
+ * @param row
+ * : Pixel x0 of the row in the color buffer, pixels up to x1 must follow
+ * it in memory.
+ * @param py
+ * : Pixel center y of the row.
+ * @param row0, row1, row2
+ * : Row part of the edge equations, l.y * py + l.z.
+ * @tparam Full
+ * : Span is known to be fully covered, skip the edge tests.
+ * ****************************************************************************************************
+*/
+template <typename Shader, bool Full>
+void RasterizeSpan(GLPbo::TriangleSetup const& s, Shader const& shader, GLPbo::Color* row, GLint x0, GLint x1,
+	float py, float row0, float row1, float row2)
+{
+	SIMD::Int lane = SIMD::LaneIndex();
+	SIMD::Float center = SIMD::ToFloat(lane) + SIMD::Set1(0.5f);
+	SIMD::Float zero = SIMD::Set1(0.f);
+	Varyings<Shader> v;
+
+	for (GLint x = x0; x < x1; x += SIMD::width)
+	{
+		SIMD::Float px = SIMD::Set1(static_cast<float>(x)) + center;
+		SIMD::Float eval0 = SIMD::Set1(s.l0.x) * px + SIMD::Set1(row0);
+		SIMD::Float eval1 = SIMD::Set1(s.l1.x) * px + SIMD::Set1(row1);
+		SIMD::Float eval2 = SIMD::Set1(s.l2.x) * px + SIMD::Set1(row2);
+		SIMD::Int mask = SIMD::Set1(x1 - x) > lane;
+		if (!Full)
+		{
+			mask = mask & (s.l0_tl ? eval0 >= zero : eval0 > zero)
+				& (s.l1_tl ? eval1 >= zero : eval1 > zero)
+				& (s.l2_tl ? eval2 >= zero : eval2 > zero);
+			if (!SIMD::Any(mask))
+			{
+				continue;
+			}
+		}
+		Interpolate<Shader::varyings>(s, eval0, eval1, eval2, v);
+		SIMD::MaskStore(reinterpret_cast<uint32_t*>(row + (x - x0)), mask, Shade(s, shader, px, py, v));
+	}
+}
+
+/*!
+ * @brief ___ScanRect___
+ * ****************************************************************************************************
+ * Scans [x0,x1) x [y0,y1) of a set up triangle one row at a time, testing
+ * every pixel. Used for triangles too small to be worth classifying blocks.
+ * ****************************************************************************************************
+ * @tparam Shader
+ * : Shader the triangle is drawn with, see shaders.h.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+void ScanRect(GLPbo::TriangleSetup const& s, Shader const& shader, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	for (GLint y = y0; y < y1; ++y)
+	{
+		// row part of the edge equations
+		float py = y + 0.5f;
+		float row0 = s.l0.y * py + s.l0.z;
+		float row1 = s.l1.y * py + s.l1.z;
+		float row2 = s.l2.y * py + s.l2.z;
+
+		// in block layout a row is only contiguous within a block
+		for (GLint sx = x0; sx < x1;)
+		{
+			GLint ex = GLPbo::block_layout ? std::min((sx / block_size + 1) * block_size, x1) : x1;
+			RasterizeSpan<Shader, false>(s, shader, Blocks::ColorAt(sx, y), sx, ex, py, row0, row1, row2);
+			sx = ex;
+		}
+	}
+}
+
+/*!
+ * @brief ___EdgeBounds___
+ * ****************************************************************************************************
+ * Smallest and largest value an edge function takes over the pixel centers
+ * [px0,px1] x [py0,py1] of a block. Edge values are evaluated with the same
+ * expression as the span kernels, l.x * px + (l.y * py + l.z), which is
+ * monotonic in px and py even with float rounding, so the bounds are taken
+ * at the block's corner pixels and are exact.
+ * ****************************************************************************************************
+*/
+inline void EdgeBounds(glm::vec3 const& l, float px0, float px1, float py0, float py1, float& emin, float& emax)
+{
+	float row_min = l.y * (l.y >= 0.f ? py0 : py1) + l.z;
+	float row_max = l.y * (l.y >= 0.f ? py1 : py0) + l.z;
+	emin = l.x * (l.x >= 0.f ? px0 : px1) + row_min;
+	emax = l.x * (l.x >= 0.f ? px1 : px0) + row_max;
+}
+
+/*!
+ * @brief ___DepthBounds___
+ * ****************************************************************************************************
+ * Smallest and largest depth of a triangle over the pixel centers
+ * [px0,px1] x [py0,py1] of a block. The depth plane has the same form as
+ * the edge equations and is clamped to the vertex depths per pixel as well,
+ * so these bounds are exact too.
+ * ****************************************************************************************************
+*/
+inline void DepthBounds(GLPbo::TriangleSetup const& s, float px0, float px1, float py0, float py1, float& zlo, float& zhi)
+{
+	EdgeBounds(s.z_plane, px0, px1, py0, py1, zlo, zhi);
+	zlo = std::min(std::max(zlo, s.zmin), s.zmax);
+	zhi = std::min(std::max(zhi, s.zmin), s.zmax);
+}
+
+/*!
+ * @brief ___DepthTest___
+ * ****************************************************************************************************
+ * Interpolates the depth of SIMD::width pixels of a row and writes it to
+ * the depth buffer where it is less than the stored depth.
+ * ****************************************************************************************************
+ * @param zrow
+ * : Depth of the first lane in the depth buffer.
+ * @param px
+ * : Pixel center x of each lane.
+ * @param zrow_part
+ * : Row part of the depth plane, z_plane.y * py + z_plane.z.
+ * @param mask
+ * : Lanes covered by the triangle.
+ * @param test
+ * : False if the block is known to be nearer than the depth buffer.
+ * @return SIMD::Int
+ * : Lanes of mask that passed the depth test.
+ * ****************************************************************************************************
+*/
+inline SIMD::Int DepthTest(GLPbo::TriangleSetup const& s, GLfloat* zrow, SIMD::Float px, float zrow_part, SIMD::Int mask, bool test)
+{
+	SIMD::Float z = SIMD::Set1(s.z_plane.x) * px + SIMD::Set1(zrow_part);
+	z = SIMD::Min(SIMD::Max(z, SIMD::Set1(s.zmin)), SIMD::Set1(s.zmax));
+	if (test)
+	{
+		mask = mask & (z < SIMD::MaskLoad(zrow, mask));
+	}
+	SIMD::MaskStore(zrow, mask, z);
+	return mask;
+}
+
+/*!
+ * @brief ___RasterizeSpanDepth___
+ * ****************************************************************************************************
+ * Depth tested counterpart of RasterizeSpan(), scans pixels [x0,x1) of one
+ * row SIMD::width pixels at a time.
+ * ****************************************************************************************************
+ * @param zrow
+ * : Pixel x0 of the row in the depth buffer, pixels up to x1 must follow
+ * it in memory.
+ * @param full
+ * : Span is known to be fully covered, skip the edge tests.
+ * @param test
+ * : False if the span is known to be nearer than the depth buffer.
+ * @return unsigned
+ * : Pixels written, bit i for pixel x0 + i.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+unsigned RasterizeSpanDepth(GLPbo::TriangleSetup const& s, Shader const& shader, GLPbo::Color* row, GLfloat* zrow, GLint x0, GLint x1,
+	float py, float row0, float row1, float row2, float zrow_part, bool full, bool test)
+{
+	SIMD::Int lane = SIMD::LaneIndex();
+	SIMD::Float center = SIMD::ToFloat(lane) + SIMD::Set1(0.5f);
+	SIMD::Float zero = SIMD::Set1(0.f);
+	Varyings<Shader> v;
+	unsigned written = 0;
+
+	for (GLint x = x0; x < x1; x += SIMD::width)
+	{
+		SIMD::Float px = SIMD::Set1(static_cast<float>(x)) + center;
+		SIMD::Float eval0 = SIMD::Set1(s.l0.x) * px + SIMD::Set1(row0);
+		SIMD::Float eval1 = SIMD::Set1(s.l1.x) * px + SIMD::Set1(row1);
+		SIMD::Float eval2 = SIMD::Set1(s.l2.x) * px + SIMD::Set1(row2);
+		SIMD::Int mask = SIMD::Set1(x1 - x) > lane;
+		if (!full)
+		{
+			mask = mask & (s.l0_tl ? eval0 >= zero : eval0 > zero)
+				& (s.l1_tl ? eval1 >= zero : eval1 > zero)
+				& (s.l2_tl ? eval2 >= zero : eval2 > zero);
+			if (!SIMD::Any(mask))
+			{
+				continue;
+			}
+		}
+		mask = DepthTest(s, zrow + (x - x0), px, zrow_part, mask, test);
+		if (!SIMD::Any(mask))
+		{
+			continue;
+		}
+
+		Interpolate<Shader::varyings>(s, eval0, eval1, eval2, v);
+		SIMD::MaskStore(reinterpret_cast<uint32_t*>(row + (x - x0)), mask, Shade(s, shader, px, py, v));
+		written |= static_cast<unsigned>(SIMD::Bits(mask)) << (x - x0);
+	}
+	return written;
+}
+
+/*!
+ * @brief ___RasterizeRect___
+ * ****************************************************************************************************
+ * Scans [x0,x1) x [y0,y1) of a set up triangle in screen aligned blocks of
+ * block_size x block_size pixels. Each block is first tested against the
+ * edge equations:
+ * - outside of any edge: skipped without touching its pixels,
+ * - inside all edges: filled without per pixel edge tests,
+ * - otherwise: scanned with the per pixel span kernels.
+ * With depth testing, blocks whose nearest depth is not less than their
+ * hierarchical z bound are skipped as well.
+ * ****************************************************************************************************
+ * @tparam Shader
+ * : Shader the triangle is drawn with, see shaders.h.
+ * @tparam Depth
+ * : Depth test against GLPbo::depth_buffer.
+ * ****************************************************************************************************
+*/
+template <typename Shader, bool Depth>
+void RasterizeRect(GLPbo::TriangleSetup const& s, Shader const& shader, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	for (GLint by = y0 - y0 % block_size; by < y1; by += block_size)
+	{
+		GLint by0 = std::max(by, y0), by1 = std::min(by + block_size, y1);
+		for (GLint bx = x0 - x0 % block_size; bx < x1; bx += block_size)
+		{
+			GLint bx0 = std::max(bx, x0), bx1 = std::min(bx + block_size, x1);
+			float px0 = bx0 + 0.5f, px1 = (bx1 - 1) + 0.5f;
+			float py0 = by0 + 0.5f, py1 = (by1 - 1) + 0.5f;
+
+			float min0, max0, min1, max1, min2, max2;
+			EdgeBounds(s.l0, px0, px1, py0, py1, min0, max0);
+			EdgeBounds(s.l1, px0, px1, py0, py1, min1, max1);
+			EdgeBounds(s.l2, px0, px1, py0, py1, min2, max2);
+
+			// trivial reject, no pixel of the block passes one of the edges
+			if (!PointInEdgeTopLeftOptimized(max0, s.l0_tl) || !PointInEdgeTopLeftOptimized(max1, s.l1_tl) || !PointInEdgeTopLeftOptimized(max2, s.l2_tl))
+			{
+				continue;
+			}
+			// trivial accept, every pixel of the block passes all edges
+			bool full = PointInEdgeTopLeftOptimized(min0, s.l0_tl) && PointInEdgeTopLeftOptimized(min1, s.l1_tl) && PointInEdgeTopLeftOptimized(min2, s.l2_tl);
+
+			// hierarchical z, reject the block if it is behind everything in
+			// it and skip the per pixel depth test if it is nearer
+			bool test = true;
+			uint64_t written = 0;
+			float zlo = 0.f, zhi = 0.f;
+			if (Depth)
+			{
+				DepthBounds(s, px0, px1, py0, py1, zlo, zhi);
+				size_t hiz = HiZ::Index(bx, by);
+				if (zlo >= HiZ::zmax[hiz])
+				{
+					continue;
+				}
+				test = zhi >= HiZ::zmin[hiz];
+			}
+
+			for (GLint y = by0; y < by1; ++y)
+			{
+				GLPbo::Color* row = Blocks::ColorAt(bx0, y);
+				if (full && Shader::varyings == 0 && !Depth)
+				{
+					std::fill(row, row + (bx1 - bx0), s.clr);
+					continue;
+				}
+				// row part of the edge equations
+				float py = y + 0.5f;
+				float row0 = s.l0.y * py + s.l0.z;
+				float row1 = s.l1.y * py + s.l1.z;
+				float row2 = s.l2.y * py + s.l2.z;
+				if (Depth)
+				{
+					GLfloat* zrow = Blocks::DepthAt(bx0, y);
+					uint64_t bits = RasterizeSpanDepth<Shader>(s, shader, row, zrow, bx0, bx1, py, row0, row1, row2, s.z_plane.y * py + s.z_plane.z, full, test);
+					written |= bits << ((y - by) * block_size + (bx0 - bx));
+				}
+				else if (full)
+				{
+					RasterizeSpan<Shader, true>(s, shader, row, bx0, bx1, py, row0, row1, row2);
+				}
+				else
+				{
+					RasterizeSpan<Shader, false>(s, shader, row, bx0, bx1, py, row0, row1, row2);
+				}
+			}
+			if (written)
+			{
+				HiZ::Update(bx, by, zlo, zhi, written);
+			}
+		}
+	}
+}
+
+/*!
+ * @brief ___FixedBlockEdge___
+ * ****************************************************************************************************
+ * A fixed point edge equation stepped from block to block. The top left
+ * rule is folded into e as a bias of -1 on edges that are not top left, so
+ * a pixel is inside the edge if its value is >= 0.
+ * ****************************************************************************************************
+*/
+struct FixedBlockEdge
+{
+	long long	e;				/*!< value at the first pixel center of the current block */
+	long long	dx, dy;			/*!< change per pixel step in x and y */
+	long long	bx, by;			/*!< change per block step in x and y */
+	long long	lo, hi;			/*!< bounds over the pixel centers of a whole block, relative to e */
+
+	FixedBlockEdge(GLPbo::TriangleSetup::FixedEdge const& f, bool tl, GLint x, GLint y)
+	{
+		constexpr long long one = 1 << GLPbo::subpixel_bits;
+		dx = f.a * one;
+		dy = f.b * one;
+		bx = dx * block_size;
+		by = dy * block_size;
+		e = f.a * (x * one + one / 2) + f.b * (y * one + one / 2) + f.c - (tl ? 0 : 1);
+		lo = (std::min(dx, 0LL) + std::min(dy, 0LL)) * (block_size - 1);
+		hi = (std::max(dx, 0LL) + std::max(dy, 0LL)) * (block_size - 1);
+	}
+
+	// value at pixel (i, j) of the current block
+	long long At(GLint i, GLint j) const { return e + dx * i + dy * j; }
+};
+
+/*!
+ * @brief ___SaturateEdge___
+ * ****************************************************************************************************
+ * Clamps a fixed point edge value to +-2^30. The span kernels step it by
+ * under 80 edge steps, lanes past the span and the step after the last
+ * group included, under 2^30 in range, so a clamped value keeps the sign
+ * of every pixel it is stepped to and never overflows int32.
+ * ****************************************************************************************************
+*/
+inline int32_t SaturateEdge(long long e)
+{
+	constexpr long long limit = 1LL << 30;
+	return static_cast<int32_t>(std::min(std::max(e, -limit), limit));
+}
+
+/*!
+ * @brief ___FixedRowSteps___
+ * ****************************************************************************************************
+ * How the three int32 edge values of a fixed point triangle change along a
+ * row, over the lanes of a group and from one group to the next. Set up
+ * once per triangle, SSE2 has no 32-bit multiply to build them per span.
+ * ****************************************************************************************************
+*/
+struct FixedRowSteps
+{
+	SIMD::Int ramp0, ramp1, ramp2;
+	SIMD::Int step0, step1, step2;
+
+	FixedRowSteps(int32_t dx0, int32_t dx1, int32_t dx2)
+		: ramp0(SIMD::Ramp(0, dx0)), ramp1(SIMD::Ramp(0, dx1)), ramp2(SIMD::Ramp(0, dx2)),
+		step0(SIMD::Set1(dx0 * SIMD::width)), step1(SIMD::Set1(dx1 * SIMD::width)), step2(SIMD::Set1(dx2 * SIMD::width))
+	{
+	}
+};
+
+/*!
+ * @brief ___RasterizeSpanFixed___
+ * ****************************************************************************************************
+ * Fixed point counterpart of RasterizeSpan(), scans pixels [x0,x1) of one
+ * row SIMD::width pixels at a time.
+ * ****************************************************************************************************
+ * @param row
+ * : Pixel x0 of the row in the color buffer, pixels up to x1 must follow
+ * it in memory.
+ * @param r0, r1, r2
+ * : Edge values at pixel x0, with every pixel of the span in int32.
+ * @param d
+ * : Steps of the edge values along the row.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+inline void RasterizeSpanFixed(GLPbo::TriangleSetup const& s, Shader const& shader, uint32_t* row, GLint x0, GLint x1,
+	float py, int32_t r0, int32_t r1, int32_t r2, FixedRowSteps const& d)
+{
+	// row part of the varying planes
+	float rows[GLPbo::max_varyings];
+	for (int k = 0; k < Shader::varyings; ++k)
+	{
+		rows[k] = s.k1[k] * py + s.k2[k];
+	}
+	float q_row = s.q_k.y * py + s.q_k.z;
+
+	SIMD::Int lane = SIMD::LaneIndex();
+	SIMD::Int outside = SIMD::Set1(-1);
+	SIMD::Float center = SIMD::ToFloat(lane) + SIMD::Set1(0.5f);
+	SIMD::Int e0 = SIMD::Set1(r0) + d.ramp0, e1 = SIMD::Set1(r1) + d.ramp1, e2 = SIMD::Set1(r2) + d.ramp2;
+	Varyings<Shader> v;
+
+	for (GLint i = 0; i < x1 - x0; i += SIMD::width, e0 = e0 + d.step0, e1 = e1 + d.step1, e2 = e2 + d.step2)
+	{
+		// a pixel is inside when no edge value has its sign bit set
+		SIMD::Int mask = (SIMD::Set1(x1 - x0 - i) > lane) & ((e0 | e1 | e2) > outside);
+		if (!SIMD::Any(mask))
+		{
+			continue;
+		}
+		SIMD::Float px = SIMD::Set1(static_cast<float>(x0 + i)) + center;
+		InterpolateFixed<Shader::varyings>(s, px, rows, q_row, v);
+		SIMD::MaskStore(row + i, mask, Shade(s, shader, px, py, v));
+	}
+}
+
+/*!
+ * @brief ___ScanRowsFixed___
+ * ****************************************************************************************************
+ * Body of ScanRectFixed(), scans [x0,x1) x [y0,y1) one row at a time from
+ * the edges at pixel (x0, y0).
+ * ****************************************************************************************************
+ * @tparam Narrow
+ * : The edge values of every pixel of the rectangle fit in int32 and the
+ * rows are contiguous, so rows are stepped in int32 and scanned as one
+ * span. Otherwise edge values are stepped exactly in 64 bits to the start
+ * of each span of up to 64 pixels, or of a block's row in block layout,
+ * and saturated to int32 for the span, see SaturateEdge().
+ * ****************************************************************************************************
+*/
+template <typename Shader, bool Narrow>
+void ScanRowsFixed(GLPbo::TriangleSetup const& s, Shader const& shader, FixedBlockEdge e0, FixedBlockEdge e1, FixedBlockEdge e2,
+	GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	constexpr GLint max_span = 64;
+	FixedRowSteps d(static_cast<int32_t>(e0.dx), static_cast<int32_t>(e1.dx), static_cast<int32_t>(e2.dx));
+	int32_t dy0 = static_cast<int32_t>(e0.dy), dy1 = static_cast<int32_t>(e1.dy), dy2 = static_cast<int32_t>(e2.dy);
+	int32_t n0 = Narrow ? static_cast<int32_t>(e0.e) : 0, n1 = Narrow ? static_cast<int32_t>(e1.e) : 0, n2 = Narrow ? static_cast<int32_t>(e2.e) : 0;
+
+	for (GLint y = y0; y < y1; ++y)
+	{
+		float py = y + 0.5f;
+		if (Narrow)
+		{
+			RasterizeSpanFixed<Shader>(s, shader, &Blocks::ColorAt(x0, y)->raw, x0, x1, py, n0, n1, n2, d);
+			n0 += dy0, n1 += dy1, n2 += dy2;
+			continue;
+		}
+
+		// in block layout a row is only contiguous within a block
+		for (GLint sx = x0; sx < x1;)
+		{
+			GLint ex = std::min(GLPbo::block_layout ? (sx / block_size + 1) * block_size : sx + max_span, x1);
+			RasterizeSpanFixed<Shader>(s, shader, &Blocks::ColorAt(sx, y)->raw, sx, ex, py,
+				SaturateEdge(e0.At(sx - x0, 0)), SaturateEdge(e1.At(sx - x0, 0)), SaturateEdge(e2.At(sx - x0, 0)), d);
+			sx = ex;
+		}
+		e0.e += e0.dy, e1.e += e1.dy, e2.e += e2.dy;
+	}
+}
+
+/*!
+ * @brief ___ScanRectFixed___
+ * ****************************************************************************************************
+ * Fixed point counterpart of ScanRect(). Small rectangles, whose edge
+ * values all fit in int32, are scanned entirely in int32 like the blocks
+ * of RasterizeRectFixed(), long thin ones in 64 bits, see ScanRowsFixed().
+ * ****************************************************************************************************
+ * @tparam Shader
+ * : Shader the triangle is drawn with, see shaders.h.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+void ScanRectFixed(GLPbo::TriangleSetup const& s, Shader const& shader, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	FixedBlockEdge e0(s.f0, s.l0_tl, x0, y0), e1(s.f1, s.l1_tl, x0, y0), e2(s.f2, s.l2_tl, x0, y0);
+
+	// bounds over the rectangle, the lanes and the step past the end of its
+	// rows and the row past it the last steps land on
+	auto narrow = [x0, y0, x1, y1](FixedBlockEdge const& e)
+	{
+		return std::abs(e.e) + std::abs(e.dx) * (x1 - x0 + 2 * SIMD::width) + std::abs(e.dy) * (y1 - y0) <= std::numeric_limits<int32_t>::max();
+	};
+	!GLPbo::block_layout && narrow(e0) && narrow(e1) && narrow(e2) ?
+		ScanRowsFixed<Shader, true>(s, shader, e0, e1, e2, x0, y0, x1, y1) :
+		ScanRowsFixed<Shader, false>(s, shader, e0, e1, e2, x0, y0, x1, y1);
+}
+
+/*!
+ * @brief ___RasterizeRectFixed___
+ * ****************************************************************************************************
+ * Fixed point counterpart of RasterizeRect(). Blocks are classified with
+ * exact 64-bit edge values, stepped from block to block, and the bounds of
+ * a whole block, which also hold for the blocks clipped by the rectangle.
+ * Inside a partially covered block, an edge that crosses the block has all
+ * its values bounded by the block's extent times the edge's gradient,
+ * which GLPbo::fixed_max_coord keeps in int32, so the per pixel tests run
+ * SIMD::width pixels at a time in 32-bit integer lanes. Edges that the
+ * whole block is inside of are not tested at all.
+ * ****************************************************************************************************
+ * @tparam Shader
+ * : Shader the triangle is drawn with, see shaders.h.
+ * @tparam Depth
+ * : Depth test against GLPbo::depth_buffer.
+ * ****************************************************************************************************
+*/
+template <typename Shader, bool Depth>
+void RasterizeRectFixed(GLPbo::TriangleSetup const& s, Shader const& shader, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	SIMD::Int lane = SIMD::LaneIndex();
+	SIMD::Int outside = SIMD::Set1(-1);
+	SIMD::Float center = SIMD::ToFloat(lane) + SIMD::Set1(0.5f);
+	Varyings<Shader> v;
+
+	// edges at the first block of each block row, edge steps fit in int32 in range
+	GLint bx_start = x0 - x0 % block_size, by_start = y0 - y0 % block_size;
+	FixedBlockEdge row_e0(s.f0, s.l0_tl, bx_start, by_start);
+	FixedBlockEdge row_e1(s.f1, s.l1_tl, bx_start, by_start);
+	FixedBlockEdge row_e2(s.f2, s.l2_tl, bx_start, by_start);
+	int32_t dx0 = static_cast<int32_t>(row_e0.dx), dx1 = static_cast<int32_t>(row_e1.dx), dx2 = static_cast<int32_t>(row_e2.dx);
+	SIMD::Int ramp0 = SIMD::Ramp(0, dx0), ramp1 = SIMD::Ramp(0, dx1), ramp2 = SIMD::Ramp(0, dx2);
+
+	for (GLint by = by_start; by < y1; by += block_size, row_e0.e += row_e0.by, row_e1.e += row_e1.by, row_e2.e += row_e2.by)
+	{
+		GLint by0 = std::max(by, y0), bh = std::min(by + block_size, y1) - by0;
+		FixedBlockEdge e0 = row_e0, e1 = row_e1, e2 = row_e2;
+		for (GLint bx = bx_start; bx < x1; bx += block_size, e0.e += e0.bx, e1.e += e1.bx, e2.e += e2.bx)
+		{
+			// trivial reject, no pixel of the block passes one of the edges
+			if (e0.e + e0.hi < 0 || e1.e + e1.hi < 0 || e2.e + e2.hi < 0)
+			{
+				continue;
+			}
+			// edges every pixel of the block passes
+			bool in0 = e0.e + e0.lo >= 0, in1 = e1.e + e1.lo >= 0, in2 = e2.e + e2.lo >= 0;
+			GLint bx0 = std::max(bx, x0), bw = std::min(bx + block_size, x1) - bx0;
+
+			// hierarchical z, see RasterizeRect()
+			bool test = true;
+			uint64_t written = 0;
+			float zlo = 0.f, zhi = 0.f;
+			if (Depth)
+			{
+				DepthBounds(s, bx0 + 0.5f, bx0 + bw - 0.5f, by0 + 0.5f, by0 + bh - 0.5f, zlo, zhi);
+				size_t hiz = HiZ::Index(bx, by);
+				if (zlo >= HiZ::zmax[hiz])
+				{
+					continue;
+				}
+				test = zhi >= HiZ::zmin[hiz];
+			}
+
+			for (GLint j = 0; j < bh; ++j)
+			{
+				GLint y = by0 + j;
+				uint32_t* row = &Blocks::ColorAt(bx0, y)->raw;
+				GLfloat* zrow = Blocks::DepthAt(bx0, y);
+				if (Shader::varyings == 0 && !Depth && in0 && in1 && in2)
+				{
+					std::fill(row, row + bw, s.clr.raw);
+					continue;
+				}
+
+				// values at the first pixel of the row, only needed (and only
+				// within int32) for edges that cross the block
+				int32_t r0 = in0 ? 0 : static_cast<int32_t>(e0.At(bx0 - bx, y - by));
+				int32_t r1 = in1 ? 0 : static_cast<int32_t>(e1.At(bx0 - bx, y - by));
+				int32_t r2 = in2 ? 0 : static_cast<int32_t>(e2.At(bx0 - bx, y - by));
+
+				// row part of the varying planes
+				float py = y + 0.5f;
+				float rows[GLPbo::max_varyings];
+				for (int k = 0; k < Shader::varyings; ++k)
+				{
+					rows[k] = s.k1[k] * py + s.k2[k];
+				}
+				float q_row = s.q_k.y * py + s.q_k.z;
+				float zrow_part = s.z_plane.y * py + s.z_plane.z;
+
+				for (GLint i = 0; i < bw; i += SIMD::width)
+				{
+					SIMD::Int mask = SIMD::Set1(bw - i) > lane;
+					if (!in0)
+					{
+						mask = mask & (SIMD::Set1(r0 + dx0 * i) + ramp0 > outside);
+					}
+					if (!in1)
+					{
+						mask = mask & (SIMD::Set1(r1 + dx1 * i) + ramp1 > outside);
+					}
+					if (!in2)
+					{
+						mask = mask & (SIMD::Set1(r2 + dx2 * i) + ramp2 > outside);
+					}
+					if (!SIMD::Any(mask))
+					{
+						continue;
+					}
+
+					SIMD::Float px = SIMD::Set1(static_cast<float>(bx0 + i)) + center;
+					if (Depth)
+					{
+						mask = DepthTest(s, zrow + i, px, zrow_part, mask, test);
+						if (!SIMD::Any(mask))
+						{
+							continue;
+						}
+						written |= static_cast<uint64_t>(SIMD::Bits(mask)) << ((y - by) * block_size + (bx0 - bx) + i);
+					}
+
+					InterpolateFixed<Shader::varyings>(s, px, rows, q_row, v);
+					SIMD::MaskStore(row + i, mask, Shade(s, shader, px, py, v));
+				}
+			}
+			if (written)
+			{
+				HiZ::Update(bx, by, zlo, zhi, written);
+			}
+		}
+	}
+}
+
+/*!
+ * @brief ___RasterizeTriangle___
+ * ****************************************************************************************************
+ * rasterize_triangle() for triangles drawn with a Shader, picks the kernel
+ * for the triangle and the rasterizer state. setup.rasterize points to it.
+ * ****************************************************************************************************
+ * @tparam Shader
+ * : Shader the triangle is drawn with, see shaders.h.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+void RasterizeTriangle(GLPbo::TriangleSetup const& setup, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	Shader const& shader = *static_cast<Shader const*>(setup.shader);
+
+	// hierarchical z is kept per block, so depth tested triangles always
+	// go through the block kernels
+	if (GLPbo::depth_test)
+	{
+		setup.fixed ?
+			RasterizeRectFixed<Shader, true>(setup, shader, x0, y0, x1, y1) :
+			RasterizeRect<Shader, true>(setup, shader, x0, y0, x1, y1);
+		return;
+	}
+
+	// block classification costs more than it saves until the rectangle
+	// spans a few blocks in both directions
+	bool blocks = x1 - x0 > 2 * block_size && y1 - y0 > 2 * block_size;
+	if (setup.fixed)
+	{
+		blocks ? RasterizeRectFixed<Shader, false>(setup, shader, x0, y0, x1, y1) : ScanRectFixed<Shader>(setup, shader, x0, y0, x1, y1);
+		return;
+	}
+	blocks ? RasterizeRect<Shader, false>(setup, shader, x0, y0, x1, y1) : ScanRect<Shader>(setup, shader, x0, y0, x1, y1);
+}
+
+/*!
+ * @brief ___rasterize_triangle___
+ * ****************************************************************************************************
+ * Fills the pixels of a set up triangle that lie in [x0,x1) x [y0,y1).
+ * The rectangle must lie in the triangle's aabb, which setup_triangle()
+ * already clamped to the viewport, so the span kernels write to the color
+ * buffer without any check. The kernels were picked for the triangle's
+ * shader when it was set up, this is the only indirect call per triangle.
+ * The tiles the rectangle touches are flagged as drawn.
+ * ****************************************************************************************************
+ * @param setup
+ * : Triangle data from setup_triangle().
+ * @param x0, y0, x1, y1
+ * : Rectangle to rasterize, max is exclusive.
+ * ****************************************************************************************************
+*/
+void GLPbo::rasterize_triangle(TriangleSetup const& setup, GLint x0, GLint y0, GLint x1, GLint y1)
+{
+	if (!ptr_to_pbo || x0 >= x1 || y0 >= y1)
+	{
+		return;
+	}
+	Tiles::Touch(x0, y0, x1, y1);
+	setup.rasterize(setup, x0, y0, x1, y1);
+}
+
+/*!
+ * @brief ___SubmitTriangle___
+ * ****************************************************************************************************
+ * Rasterizes a set up triangle right away, or bins it when GLPbo::tiled is
+ * set.
+ * ****************************************************************************************************
+*/
+void SubmitTriangle(GLPbo::TriangleSetup const& setup)
+{
+	if (GLPbo::tiled)
+	{
+		Tiles::Bin(setup);
+	}
+	else
+	{
+		GLPbo::rasterize_triangle(setup, setup.xmin, setup.ymin, setup.xmax, setup.ymax);
+	}
+}
+
+/*!
+ * @brief ___SetupVaryings___
+ * ****************************************************************************************************
+ * Computes everything the span kernels need to interpolate the first count
+ * varyings of a set up triangle's vertices, once per triangle.
+ * ****************************************************************************************************
+*/
+static void SetupVaryings(GLPbo::TriangleSetup& setup, Clip::Vertex const& v0, Clip::Vertex const& v1, Clip::Vertex const& v2, int count)
+{
+	// a flipped back face was set up as (p0, p2, p1)
+	Clip::Vertex const& q1 = setup.flipped ? v2 : v1;
+	Clip::Vertex const& q2 = setup.flipped ? v1 : v2;
+
+	// vertices at the same w need no divide per pixel, their varyings are
+	// interpolated as they are
+	setup.perspective = v0.q != q1.q || v0.q != q2.q;
+	GLfloat a0[GLPbo::max_varyings], a1[GLPbo::max_varyings], a2[GLPbo::max_varyings];
+	for (int i = 0; i < count; ++i)
+	{
+		a0[i] = setup.perspective ? v0.v[i] : v0.v[i] / v0.q;
+		a1[i] = setup.perspective ? q1.v[i] : q1.v[i] / q1.q;
+		a2[i] = setup.perspective ? q2.v[i] : q2.v[i] / q2.q;
+	}
+	glm::vec3 q(v0.q, q1.q, q2.q);
+
+	if (setup.fixed)
+	{
+		SetupVaryingPlanesFixed(setup, a0, a1, a2, count, q);
+		return;
+	}
+
+	// Barycentric interpolation reference: https://drive.google.com/file/d/1HYkDd45NZ3EfSm_ow9YMNMFxJFi8dqWY/view?usp=sharing
+	// calculate double area, edge value / double area gives the barycentric coordinate
+	float double_area = (q1.p.x - v0.p.x) * (q2.p.y - v0.p.y) - (q2.p.x - v0.p.x) * (q1.p.y - v0.p.y);
+	for (int i = 0; i < count; ++i)
+	{
+		setup.k0[i] = a0[i] / double_area;
+		setup.k1[i] = a1[i] / double_area;
+		setup.k2[i] = a2[i] / double_area;
+	}
+	setup.q_k = q / double_area;
+}
+
+/*!
+ * @brief ___DrawTriangle___
+ * ****************************************************************************************************
+ * Sets up and submits a triangle in the guard band drawn with a shader.
+ * ****************************************************************************************************
+ * @param shader
+ * : Shader that stays alive until the triangle is rasterized.
+ * @param face
+ * : Flat color, for shaders without varyings.
+ * @return bool
+ * : False if the triangle was backface-culled or is off screen.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+static bool DrawTriangle(Clip::Vertex const& v0, Clip::Vertex const& v1, Clip::Vertex const& v2, Shader const& shader, GLPbo::Color face)
+{
+	GLPbo::TriangleSetup setup;
+	if (!GLPbo::setup_triangle(v0.p, v1.p, v2.p, setup))
+	{
+		return false;
+	}
+	setup.shader = &shader;
+	setup.rasterize = RasterizeTriangle<Shader>;
+	setup.clr = face;
+	setup.perspective = false;
+	if (Shader::varyings > 0)
+	{
+		SetupVaryings(setup, v0, v1, v2, Shader::varyings);
+	}
+
+	SubmitTriangle(setup);
+	return true;
+}
+
+/*!
+ * @brief ___DrawElement___
+ * ****************************************************************************************************
+ * Draws the triangle (i0, i1, i2) of a transformed model with a shader,
+ * clipped to the near and far planes.
+ * ****************************************************************************************************
+ * @param varyings
+ * : Shader::varyings floats per vertex of the model.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+static bool DrawElement(GLPbo::Model const& model, GLuint i0, GLuint i1, GLuint i2,
+	GLfloat const* varyings, Shader const& shader, GLPbo::Color face)
+{
+	return Clip::Assemble(model, i0, i1, i2, varyings, Shader::varyings, [&shader, face](Clip::Vertex const* poly, int n)
+	{
+		auto draw = [&shader, face](Clip::Vertex const& v0, Clip::Vertex const& v1, Clip::Vertex const& v2)
+		{
+			return DrawTriangle(v0, v1, v2, shader, face);
+		};
+		bool drawn = false;
+		for (int i = 1; i + 1 < n; ++i)
+		{
+			drawn = Clip::Triangle(poly[0], poly[i], poly[i + 1], draw) || drawn;
+		}
+		return drawn;
+	});
+}
+
+/*!
+ * @brief ___render_triangle___
+ * ****************************************************************************************************
+ * reference link: https://drive.google.com/file/d/1VomuXWXlopSPPvPuC3UtZXdCIyprOORS/view?usp=sharing
+ * Renders a flat shaded triangle.
+ * ****************************************************************************************************
+ * @param p0
+ * : Vertex 1 of the triangle.
+ * @param p1
+ * : Vertex 2 of the triangle.
+ * @param p2
+ * : Vertex 3 of the triangle.
+ * @param clr
+ * : Color to shade the triangle.
+ * @return bool
+ * : If triangle was successfully rendered. I.e. not backface-culled.
+ * ****************************************************************************************************
+*/
+bool GLPbo::render_triangle(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2, glm::vec3 clr)
+{
+	return render_triangle({ p0 }, { p1 }, { p2 }, Shaders::Flat(), { (GLubyte)clr.x,(GLubyte)clr.y,(GLubyte)clr.z,255 });
+}
+
+/*!
+ * @brief ___render_triangle___
+ * ****************************************************************************************************
+ * Renders the triangle with smooth shading. I.e. same as flat shading
+ * just with barycentric interpolated colors.
+ * ****************************************************************************************************
+ * @param p0
+ * : Vertex 1 of the triangle.
+ * @param p1
+ * : Vertex 2 of the triangle.
+ * @param p2
+ * : Vertex 3 of the triangle.
+ * @param c0
+ * : Color at 1st vertex.
+ * @param c1
+ * : Color at 2nd vertex.
+ * @param c2
+ * : Color at 3rd vertex.
+ * @return bool
+ * : If triangle was successfully rendered. I.e. not backface-culled.
+ * ****************************************************************************************************
+*/
+bool GLPbo::render_triangle(glm::vec3 const& p0, glm::vec3 const& p1,
+	glm::vec3 const& p2, glm::vec3 const& c0,
+	glm::vec3 const& c1, glm::vec3 const& c2)
+{
+	return render_triangle(Clip::Window(p0, 1.f, &c0.x, 3), Clip::Window(p1, 1.f, &c1.x, 3), Clip::Window(p2, 1.f, &c2.x, 3), Shaders::Gouraud());
+}
+
+/*!
+ * @brief ___render_triangle___
+ * ****************************************************************************************************
+ * Renders a triangle with a shader and perspective-correct varyings.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+bool GLPbo::render_triangle(Vertex const& v0, Vertex const& v1, Vertex const& v2, Shader const& shader, Color face)
+{
+	Shader const& kept = tiled ? *Tiles::Keep(shader) : shader;
+	return Clip::Triangle(v0, v1, v2, [&kept, face](Vertex const& a, Vertex const& b, Vertex const& c)
+	{
+		return DrawTriangle(a, b, c, kept, face);
+	});
+}
+
+/*!
+ * @brief ___draw_elements___
+ * ****************************************************************************************************
+ * Runs a model through the vertex stage and draws its triangles in index
+ * order, filled ones with the shader of their mode.
+ * ****************************************************************************************************
+ * @param model
+ * : Model to draw.
+ * @param mode
+ * : How to draw its triangles.
+ * @param state
+ * : Transform and colors.
+ * ****************************************************************************************************
+*/
+void GLPbo::draw_elements(Model& model, DrawMode mode, DrawState const& state)
+{
+	switch (mode)
+	{
+	case DrawMode::FlatShaded:
+	{
+		Shaders::Flat flat;
+		flat.face_clr = state.face_clr;
+		draw_elements(model, flat, state.mvp);
+		return;
+	}
+	case DrawMode::SmoothShaded:
+		draw_elements(model, Shaders::Gouraud(), state.mvp);
+		return;
+	case DrawMode::NormalShaded:
+		draw_elements(model, Shaders::Normal(), state.mvp);
+		return;
+	case DrawMode::Textured:
+	{
+		if (!state.texture || model.tex.size() != model.pm.size())
+		{
+			draw_elements(model, Shaders::Gouraud(), state.mvp);
+			return;
+		}
+		Shaders::Textured textured;
+		textured.texture = state.texture;
+		textured.filter = state.filter;
+		draw_elements(model, textured, state.mvp);
+		return;
+	}
+	default:
+		break;
+	}
+
+	transform_vertices(model, state.mvp);
+	size_t faces = model.triangle_cnt();
+	model.visit_triangles([&](auto const* tri)
+	{
+		for (size_t f = 0; f < faces; ++f)
+		{
+			Color clr = state.line_clr;
+			if (mode == DrawMode::WireframeColor)
+			{
+				glm::vec3 const& c = state.face_clr[f];
+				clr = { (GLubyte)c.x, (GLubyte)c.y, (GLubyte)c.z, 255 };
+			}
+			render_triangle_wireframe(model, tri[f * 3], tri[f * 3 + 1], tri[f * 3 + 2], clr);
+		}
+	});
+}
+
+/*!
+ * @brief ___draw_elements___
+ * ****************************************************************************************************
+ * Runs a model through the vertex stage, and its vertices through the
+ * shader's vertex function, then draws its triangles in index order.
+ * Triangles go through Batch::Cull() first, so backfacing and off screen
+ * ones never reach setup, and triangles in the guard band skip the clip
+ * stage altogether.
+ * ****************************************************************************************************
+ * @param model
+ * : Model to draw.
+ * @param shader
+ * : Shader to draw its triangles with.
+ * @param mvp
+ * : Model view projection matrix.
+ * ****************************************************************************************************
+*/
+template <typename Shader>
+void GLPbo::draw_elements(Model& model, Shader const& shader, glm::mat4 const& mvp)
+{
+	// only the meshlets that survive culling go through the vertex stage
+	Clusters::Select(model, mvp);
+	for (Clusters::Run const& run : Clusters::vertices)
+	{
+		transform_vertices(model, mvp, run.first, run.count);
+	}
+	Shader const& kept = tiled ? *Tiles::Keep(shader) : shader;
+
+	// vertex shader, the varyings are copied into the setup of every
+	// triangle so the buffer can be reused by the next draw right away
+	constexpr int cnt = Shader::varyings;
+	Batch::varyings.resize(model.pm.size() * cnt);
+	for (Clusters::Run const& run : Clusters::vertices)
+	{
+		for (size_t i = run.first; cnt > 0 && i < run.first + run.count; ++i)
+		{
+			shader.vertex(model, static_cast<GLuint>(i), &Batch::varyings[i * cnt]);
+		}
+	}
+	GLfloat const* varyings = cnt > 0 ? Batch::varyings.data() : nullptr;
+
+	// the index width is dispatched once per draw, not per triangle
+	model.visit_triangles([&](auto const* tri)
+	{
+		for (Clusters::Run const& run : Clusters::triangles)
+		for (size_t first = run.first; first < run.first + run.count; first += Batch::size)
+		{
+			size_t left = run.first + run.count - first;
+			int count = Batch::Cull(model, tri, first, static_cast<int>(std::min<size_t>(Batch::size, left)));
+			for (int k = 0; k < count; ++k)
+			{
+				size_t f = Batch::face[k];
+				GLuint i0 = tri[f * 3], i1 = tri[f * 3 + 1], i2 = tri[f * 3 + 2];
+				if (Batch::clipped[k])
+				{
+					DrawElement(model, i0, i1, i2, varyings, kept, shader.face(f));
+					continue;
+				}
+
+				Batch::Positions const& p = Batch::kept;
+				glm::vec3 p0(p.x0[k], p.y0[k], p.z0[k]), p1(p.x1[k], p.y1[k], p.z1[k]), p2(p.x2[k], p.y2[k], p.z2[k]);
+				DrawTriangle(Clip::Window(p0, model.qd[i0], varyings + static_cast<size_t>(i0) * cnt, cnt),
+					Clip::Window(p1, model.qd[i1], varyings + static_cast<size_t>(i1) * cnt, cnt),
+					Clip::Window(p2, model.qd[i2], varyings + static_cast<size_t>(i2) * cnt, cnt), kept, shader.face(f));
+			}
+		}
+	});
+}
+
+// every shader of shaders.h gets its kernels compiled here
+template bool GLPbo::render_triangle<Shaders::Flat>(Vertex const&, Vertex const&, Vertex const&, Shaders::Flat const&, Color);
+template bool GLPbo::render_triangle<Shaders::Gouraud>(Vertex const&, Vertex const&, Vertex const&, Shaders::Gouraud const&, Color);
+template bool GLPbo::render_triangle<Shaders::Normal>(Vertex const&, Vertex const&, Vertex const&, Shaders::Normal const&, Color);
+template bool GLPbo::render_triangle<Shaders::Textured>(Vertex const&, Vertex const&, Vertex const&, Shaders::Textured const&, Color);
+template void GLPbo::draw_elements<Shaders::Flat>(Model&, Shaders::Flat const&, glm::mat4 const&);
+template void GLPbo::draw_elements<Shaders::Gouraud>(Model&, Shaders::Gouraud const&, glm::mat4 const&);
+template void GLPbo::draw_elements<Shaders::Normal>(Model&, Shaders::Normal const&, glm::mat4 const&);
+template void GLPbo::draw_elements<Shaders::Textured>(Model&, Shaders::Textured const&, glm::mat4 const&);
+
+/*!
+ * @brief ___Tiles::Bin___
+ * ****************************************************************************************************
+ * Stores a set up triangle and appends its index to the bin of every tile
+ * its aabb overlaps. Triangles are only ever appended, which keeps each bin
+ * in submission order.
+ * ****************************************************************************************************
+ * @param setup
+ * : Triangle to bin.
+ * ****************************************************************************************************
+*/
+void Tiles::Bin(GLPbo::TriangleSetup const& setup)
+{
+	// the aabb was clamped to the viewport, which the tiles cover exactly
+	GLuint index = static_cast<GLuint>(setups.size());
+	setups.push_back(setup);
+	for (GLint ty = setup.ymin / GLPbo::tile_size; ty <= (setup.ymax - 1) / GLPbo::tile_size; ++ty)
+	{
+		for (GLint tx = setup.xmin / GLPbo::tile_size; tx <= (setup.xmax - 1) / GLPbo::tile_size; ++tx)
+		{
+			bins[ty * cols + tx].push_back(index);
+		}
+	}
+}
+
+/*!
+ * @brief ___resolve_tiles___
+ * ****************************************************************************************************
+ * Rasterizes every binned triangle, one tile per worker task, in the order
+ * the triangles were submitted, then empties the bins. Each tile is owned by
+ * exactly one task so no two threads ever write the same pixel. The task
+ * then resolves its tile while it is still cached: with GLPbo::block_layout
+ * it detiles it into ptr_to_pbo, with GLPbo::fast_clear it fills it if
+ * nothing touched it. Frames with nothing binned are resolved in strips on
+ * all cores.
+ * ****************************************************************************************************
+*/
+void GLPbo::resolve_tiles()
+{
+	if (Tiles::setups.empty())
+	{
+		Tiles::shaders.clear();
+		if ((block_layout || fast_clear) && ptr_to_pbo)
+		{
+			// nothing binned, the tiles are resolved in strips a tile high
+			GLint strips = (height + tile_size - 1) / tile_size;
+			Tiles::workers->ParallelFor(static_cast<unsigned>(strips), [](unsigned strip)
+			{
+				for (GLint tx = 0; tx < Tiles::cols; ++tx)
+				{
+					Tiles::Resolve(static_cast<size_t>(strip) * Tiles::cols + tx);
+				}
+			});
+		}
+		return;
+	}
+
+	Tiles::workers->ParallelFor(static_cast<unsigned>(Tiles::bins.size()), [](unsigned tile)
+	{
+		GLint tx0 = (tile % Tiles::cols) * tile_size, ty0 = (tile / Tiles::cols) * tile_size;
+		GLint tx1 = std::min(tx0 + tile_size, width), ty1 = std::min(ty0 + tile_size, height);
+		for (GLuint index : Tiles::bins[tile])
+		{
+			TriangleSetup const& setup = Tiles::setups[index];
+			rasterize_triangle(setup,
+				std::max(setup.xmin, tx0), std::max(setup.ymin, ty0),
+				std::min(setup.xmax, tx1), std::min(setup.ymax, ty1));
+		}
+		// keep capacity for the next frame
+		Tiles::bins[tile].clear();
+
+		// the tile is still in this core's cache
+		if (ptr_to_pbo)
+		{
+			Tiles::Resolve(tile);
+		}
+	});
+	Tiles::setups.clear();
+	Tiles::shaders.clear();
+}
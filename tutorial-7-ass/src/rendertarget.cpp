@@ -0,0 +1,278 @@
+/* !
+@file    rendertarget.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the dirty tile tracking of class
+RenderTarget, of class HostRenderTarget and of the image writers declared
+in rendertarget.h. Nothing here needs an OpenGL context.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "rendertarget.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+
+/*!
+ * @brief ___RenderTarget::RenderTarget___
+ * ****************************************************************************************************
+ * Sets up the dirty tiles of buffers buffers, every tile is stale and
+ * changed until the first frame reports what it drew.
+ * ****************************************************************************************************
+*/
+RenderTarget::RenderTarget(GLsizei w, GLsizei h, int buffers) :
+	width(w), height(h), buffer(0), cleared_to(), reported(false)
+{
+	tile_cols = (w + GLPbo::tile_size - 1) / GLPbo::tile_size;
+	GLint rows = (h + GLPbo::tile_size - 1) / GLPbo::tile_size;
+	size_t tiles = static_cast<size_t>(tile_cols) * rows;
+	stale.assign(buffers, std::vector<unsigned char>(tiles, 1));
+	changed.assign(tiles, 1);
+	last_drawn.assign(tiles, 1);
+}
+
+/*!
+ * @brief ___RenderTarget::SetDrawn___
+ * ****************************************************************************************************
+ * Records the tiles drawn into the current buffer this frame. They are all
+ * the buffer's stale tiles now, its other stale tiles were cleared when the
+ * frame began, and the tiles Unmap() presents are those and the tiles drawn
+ * the frame before, which go back to the clear color.
+ * ****************************************************************************************************
+ * @param tiles
+ * : One flag per tile, like GLPbo::drawn_tiles.
+ * ****************************************************************************************************
+*/
+void RenderTarget::SetDrawn(std::vector<unsigned char> const& tiles)
+{
+	for (size_t i = 0; i < changed.size(); ++i)
+	{
+		changed[i] = tiles[i] | last_drawn[i];
+	}
+	last_drawn = tiles;
+	stale[buffer] = tiles;
+	reported = true;
+}
+
+/*!
+ * @brief ___RenderTarget::Invalidate___
+ * ****************************************************************************************************
+ * Forgets every buffer's contents, the next frames clear and present them
+ * whole.
+ * ****************************************************************************************************
+*/
+void RenderTarget::Invalidate()
+{
+	for (std::vector<unsigned char>& tiles : stale)
+	{
+		std::fill(tiles.begin(), tiles.end(), 1);
+	}
+	std::fill(changed.begin(), changed.end(), 1);
+	std::fill(last_drawn.begin(), last_drawn.end(), 1);
+}
+
+/*!
+ * @brief ___RenderTarget::SetClearColor___
+ * ****************************************************************************************************
+ * Called before the stale tiles are cleared. Tiles that are not stale
+ * still hold the color they were last cleared to, so another color makes
+ * every tile stale.
+ * ****************************************************************************************************
+ * @param clr
+ * : Color the frame clears to.
+ * ****************************************************************************************************
+*/
+void RenderTarget::SetClearColor(GLPbo::Color clr)
+{
+	if (clr.raw != cleared_to.raw)
+	{
+		Invalidate();
+	}
+	cleared_to = clr;
+}
+
+/*!
+ * @brief ___RenderTarget::EndFrame___
+ * ****************************************************************************************************
+ * Called once the changed tiles were presented. Unless SetDrawn() was
+ * called, the frame may have written anywhere, so the whole buffer is stale
+ * and the next frame presents everything.
+ * ****************************************************************************************************
+*/
+void RenderTarget::EndFrame()
+{
+	if (!reported)
+	{
+		std::fill(stale[buffer].begin(), stale[buffer].end(), 1);
+		std::fill(last_drawn.begin(), last_drawn.end(), 1);
+	}
+	std::fill(changed.begin(), changed.end(), 1);
+	reported = false;
+}
+
+/*!
+ * @brief ___HostRenderTarget::HostRenderTarget___
+ * ****************************************************************************************************
+ * Allocates width x height pixels starting on an alignment byte boundary.
+ * ****************************************************************************************************
+*/
+HostRenderTarget::HostRenderTarget(GLsizei w, GLsizei h) :
+	RenderTarget(w, h),
+	storage(static_cast<size_t>(w) * h * sizeof(GLPbo::Color) + alignment)
+{
+	void* ptr = storage.data();
+	size_t space = storage.size();
+	pixels = static_cast<GLPbo::Color*>(std::align(alignment, space - alignment, ptr, space));
+}
+
+/*!
+ * @brief ___WriteRows___
+ * ****************************************************************************************************
+ * Calls write(row) with the RGB bytes of every row from the top of the
+ * image to the bottom.
+ * ****************************************************************************************************
+*/
+template <typename Writer>
+static void WriteRows(GLPbo::Color const* pixels, GLsizei width, GLsizei height, Writer write)
+{
+	std::vector<unsigned char> row(static_cast<size_t>(width) * 3);
+	for (GLsizei y = height - 1; y >= 0; --y)
+	{
+		GLPbo::Color const* src = pixels + static_cast<size_t>(y) * width;
+		for (GLsizei x = 0; x < width; ++x)
+		{
+			row[x * 3 + 0] = src[x].r;
+			row[x * 3 + 1] = src[x].g;
+			row[x * 3 + 2] = src[x].b;
+		}
+		write(row);
+	}
+}
+
+/*!
+ * @brief ___WritePPM___
+ * ****************************************************************************************************
+ * Writes a color buffer to a binary (P6) PPM file, top row first.
+ * ****************************************************************************************************
+*/
+bool WritePPM(std::string const& path, GLPbo::Color const* pixels, GLsizei width, GLsizei height)
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	file << "P6\n" << width << " " << height << "\n255\n";
+	WriteRows(pixels, width, height, [&file](std::vector<unsigned char> const& row)
+	{
+		file.write(reinterpret_cast<char const*>(row.data()), row.size());
+	});
+	return static_cast<bool>(file);
+}
+
+/*!
+ * @brief ___Png___
+ * *********************
+ * Namespace that holds the checksums and chunk layout of the PNG writer.
+*/
+namespace Png
+{
+	uint32_t Crc32(uint32_t crc, unsigned char const* data, size_t size)
+	{
+		static uint32_t table[256] = {};
+		if (table[1] == 0)
+		{
+			for (uint32_t n = 0; n < 256; ++n)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; ++k)
+				{
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				}
+				table[n] = c;
+			}
+		}
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i)
+		{
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	void PutU32(std::vector<unsigned char>& out, uint32_t v)
+	{
+		out.push_back(static_cast<unsigned char>(v >> 24));
+		out.push_back(static_cast<unsigned char>(v >> 16));
+		out.push_back(static_cast<unsigned char>(v >> 8));
+		out.push_back(static_cast<unsigned char>(v));
+	}
+
+	// appends a chunk of type with data, the crc covers type and data
+	void Chunk(std::vector<unsigned char>& out, char const* type, std::vector<unsigned char> const& data)
+	{
+		PutU32(out, static_cast<uint32_t>(data.size()));
+		size_t start = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data.begin(), data.end());
+		PutU32(out, Crc32(0, out.data() + start, out.size() - start));
+	}
+}
+
+/*!
+ * @brief ___WritePNG___
+ * ****************************************************************************************************
+ * Writes a color buffer to an 8-bit RGB PNG file with stored (uncompressed)
+ * deflate blocks, top row first.
+ * ****************************************************************************************************
+*/
+bool WritePNG(std::string const& path, GLPbo::Color const* pixels, GLsizei width, GLsizei height)
+{
+	// scanlines, each prefixed with filter type 0 (none)
+	std::vector<unsigned char> raw;
+	raw.reserve(static_cast<size_t>(width * 3 + 1) * height);
+	WriteRows(pixels, width, height, [&raw](std::vector<unsigned char> const& row)
+	{
+		raw.push_back(0);
+		raw.insert(raw.end(), row.begin(), row.end());
+	});
+
+	// zlib stream made of stored deflate blocks of at most 65535 bytes
+	std::vector<unsigned char> zlib = { 0x78, 0x01 };
+	size_t const block_max = 65535;
+	for (size_t pos = 0; pos < raw.size(); pos += block_max)
+	{
+		size_t len = std::min(block_max, raw.size() - pos);
+		zlib.push_back(pos + len >= raw.size() ? 1 : 0);
+		zlib.push_back(static_cast<unsigned char>(len));
+		zlib.push_back(static_cast<unsigned char>(len >> 8));
+		zlib.push_back(static_cast<unsigned char>(~len));
+		zlib.push_back(static_cast<unsigned char>(~len >> 8));
+		zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+	}
+	uint32_t a = 1, b = 0;
+	for (unsigned char byte : raw)
+	{
+		a = (a + byte) % 65521;
+		b = (b + a) % 65521;
+	}
+	Png::PutU32(zlib, (b << 16) | a);
+
+	std::vector<unsigned char> ihdr;
+	Png::PutU32(ihdr, static_cast<uint32_t>(width));
+	Png::PutU32(ihdr, static_cast<uint32_t>(height));
+	ihdr.insert(ihdr.end(), { 8, 2, 0, 0, 0 });	/*!< 8-bit, truecolor, deflate, adaptive filter, no interlace */
+
+	std::vector<unsigned char> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	Png::Chunk(png, "IHDR", ihdr);
+	Png::Chunk(png, "IDAT", zlib);
+	Png::Chunk(png, "IEND", {});
+
+	std::ofstream file(path, std::ios::binary);
+	file.write(reinterpret_cast<char const*>(png.data()), png.size());
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,405 @@
+/* !
+@file    scene.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of the functions declared in scene.h
+that do not need an OpenGL context.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "scene.h"
+#include "meshcache.h"
+#include "meshopt.h"
+#include "objparser.h"
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// dpml.lib only ships for Visual Studio, see prop-pages/assignment.props,
+// other builds define SCENE_HAS_DPML themselves if they link a DPML
+#if defined(_MSC_VER) && !defined(SCENE_NO_DPML) && !defined(SCENE_HAS_DPML)
+#define SCENE_HAS_DPML
+#endif
+
+#ifdef SCENE_HAS_DPML
+#include <dpml.h>
+#endif
+
+namespace Scene
+{
+	unsigned int				current_model = 0;
+	std::vector<GLPbo::Model>	models;
+	DrawMode					current_draw_mode = DrawMode::Wireframe;
+	bool						rotate = false;
+	double						orientation = 0;
+	glm::mat4					view_projection{ 1.f };
+	GLPbo::Texture				texture;
+	GLPbo::Texture::Filter		texture_filter = GLPbo::Texture::Filter::Trilinear;
+	bool						mesh_cache = true;
+	bool						parallel_obj = true;
+	bool						optimize_meshes = true;
+
+	/*!
+	 * @brief ___Scene::BuildModel___
+	 * *******************************
+	 * Parses an OBJ file into a model, with ObjParser unless parallel_obj
+	 * is cleared, and post-processes it for the emulator. ObjParser runs on
+	 * the rasterizer's workers, on this thread alone if they are not
+	 * there. Its indices are narrowed to 16 bits when the model is small enough,
+	 * DPML's are 16-bit and can only address 65536 vertices. Builds without
+	 * SCENE_HAS_DPML fail to parse when parallel_obj is cleared. Unless
+	 * optimize_meshes is cleared, the triangles and vertices are then
+	 * reordered for the vertex cache, see meshopt.h, and the average cache
+	 * miss ratio before and after is printed.
+	 * MeshCache::version must be bumped whenever this changes.
+	 * **************
+	 * @param path
+	 * : Path of the .obj file.
+	 * @param model
+	 * : Empty model to build.
+	 * @return bool
+	 * : False if the .obj file could not be parsed.
+	*/
+	static bool BuildModel(std::string const& path, GLPbo::Model& model)
+	{
+		if (parallel_obj)
+		{
+			std::vector<GLuint> triangles;
+			if (!ObjParser::Parse(path, model.pm, model.nml, model.tex, triangles, true, true, true, GLPbo::rasterizer_workers()))
+			{
+				return false;
+			}
+			model.set_triangles(std::move(triangles));
+		}
+		else
+		{
+#ifdef SCENE_HAS_DPML
+			if (!DPML::parse_obj_mesh(path, model.pm, model.nml, model.tex, model.tri, true, true, true))
+			{
+				return false;
+			}
+			// rather than draw indices that wrapped around
+			if (model.pm.size() > std::numeric_limits<unsigned short>::max() + size_t(1))
+			{
+				std::cout << "parse " << path << " failed, its " << model.pm.size()
+					<< " vertices do not fit DPML's 16-bit indices" << std::endl;
+				model = GLPbo::Model();
+				return false;
+			}
+#else
+			std::cout << "parse " << path << " failed, built without DPML" << std::endl;
+			return false;
+#endif
+		}
+
+		for (auto& nml : model.nml)
+		{
+			nml += glm::vec3(1, 1, 1);
+			nml = nml * 0.5f;
+		}
+
+		// models without texture coordinates get the spherical
+		// projection of their (centered) positions, u around y
+		if (model.tex.size() != model.pm.size())
+		{
+			float const pi = 3.14159265f;
+			model.tex.resize(model.pm.size());
+			for (size_t i = 0; i < model.pm.size(); ++i)
+			{
+				glm::vec3 const& p = model.pm[i];
+				float len = glm::length(p);
+				model.tex[i].x = 0.5f + std::atan2(p.z, p.x) / (2.f * pi);
+				model.tex[i].y = len > 0.f ? 0.5f + std::asin(p.y / len) / pi : 0.5f;
+			}
+		}
+
+		if (optimize_meshes)
+		{
+			MeshOpt::Stats stats = MeshOpt::Optimize(model);
+			std::cout << "optimized " << path << ": ACMR " << stats.acmr_before
+				<< " -> " << stats.acmr_after << std::endl;
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief ___Scene::LoadScene___
+	 * *******************************
+	 * Loads a scene from a .scn file. Each model is built from its OBJ file
+	 * once, then loaded from the binary cache written next to it, see
+	 * meshcache.h, unless mesh_cache is cleared, and split into meshlets.
+	 * A cache built with another parallel_obj or optimize_meshes than the
+	 * current ones is rebuilt.
+	 * **************
+	 * @param scene 
+	 * : Path of the .scn file.
+	 * @return bool
+	 * : False if the .scn file could not be read.
+	*/
+	bool LoadScene(const std::string& scene)
+	{
+		std::ifstream file(scene);
+		if (file)
+		{
+			// the options BuildModel() builds differently with
+			uint32_t build_flags = (parallel_obj ? 0u : 1u) | (optimize_meshes ? 2u : 0u);
+			std::string line;
+			while (file >> line)
+			{
+				models.push_back(GLPbo::Model());
+				std::string path = "../meshes/" + line + ".obj";
+				if (mesh_cache)
+				{
+					MeshCache::Load(path, models.back(), BuildModel, build_flags);
+				}
+				else
+				{
+					BuildModel(path, models.back());
+				}
+				// meshlets are cheap to build and not worth a cache version
+				MeshOpt::BuildMeshlets(models.back());
+			}
+		}
+		else
+		{
+			std::cout << "read scene failed" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief ___Scene::CompareParsers___
+	 * *******************************
+	 * Parses every model of a .scn file with both ObjParser and
+	 * DPML::parse_obj_mesh() and prints how their outputs differ: the
+	 * vertex and triangle counts, whether the indices are the same, and by
+	 * how much the position, normal and texture coordinate of every
+	 * triangle corner differ. The vertices may be numbered differently, a
+	 * model matches as long as its triangles, read through their indices,
+	 * are the same within 1e-4.
+	 * **************
+	 * @param scene
+	 * : Path of the .scn file.
+	 * @return bool
+	 * : False if any model did not match or could not be parsed, or if
+	 * this build has no DPML to compare with.
+	*/
+	bool CompareParsers(const std::string& scene)
+	{
+#ifdef SCENE_HAS_DPML
+		std::ifstream file(scene);
+		if (!file)
+		{
+			std::cout << "read scene failed" << std::endl;
+			return false;
+		}
+		// the parsers read floats in different ways, they may round differently
+		float const tolerance = 1e-4f;
+		bool all_match = true;
+		std::string line;
+		while (file >> line)
+		{
+			std::string path = "../meshes/" + line + ".obj";
+			std::vector<glm::vec3> pm, nml, dpml_pm, dpml_nml;
+			std::vector<glm::vec2> tex, dpml_tex;
+			std::vector<GLuint> tri;
+			std::vector<unsigned short> dpml_tri;
+			if (!ObjParser::Parse(path, pm, nml, tex, tri, true, true, true, GLPbo::rasterizer_workers()) ||
+				!DPML::parse_obj_mesh(path, dpml_pm, dpml_nml, dpml_tex, dpml_tri, true, true, true))
+			{
+				std::cout << "compare " << path << " failed, it could not be parsed" << std::endl;
+				all_match = false;
+				continue;
+			}
+
+			// largest difference of any component of an attribute between the
+			// corners of both outputs
+			auto corner_diff = [&](auto const& ours, auto const& theirs)
+			{
+				float diff = 0.f;
+				for (size_t i = 0; i < tri.size(); ++i)
+				{
+					auto d = glm::abs(ours[tri[i]] - theirs[dpml_tri[i]]);
+					for (int c = 0; c < d.length(); ++c)
+					{
+						diff = std::max(diff, d[c]);
+					}
+				}
+				return diff;
+			};
+			// DPML's indices wrap around past 65536 vertices
+			bool comparable = tri.size() == dpml_tri.size() &&
+				dpml_pm.size() <= std::numeric_limits<unsigned short>::max() + size_t(1) &&
+				nml.size() == pm.size() && dpml_nml.size() == dpml_pm.size() &&
+				tex.empty() == dpml_tex.empty();
+			float pm_diff = comparable ? corner_diff(pm, dpml_pm) : 0.f;
+			float nml_diff = comparable ? corner_diff(nml, dpml_nml) : 0.f;
+			float tex_diff = comparable && !tex.empty() ? corner_diff(tex, dpml_tex) : 0.f;
+			bool match = comparable && pm_diff <= tolerance && nml_diff <= tolerance &&
+				tex_diff <= tolerance;
+			bool same_indices = tri.size() == dpml_tri.size() && std::equal(tri.begin(), tri.end(), dpml_tri.begin());
+
+			std::cout << path << ": " << pm.size() << " vs " << dpml_pm.size() << " vertices, "
+				<< tri.size() / 3 << " vs " << dpml_tri.size() / 3 << " triangles, "
+				<< (same_indices ? "same" : "different") << " indices";
+			if (comparable)
+			{
+				std::cout << ", corners differ by up to " << pm_diff << " in position, " << nml_diff
+					<< " in normal, " << tex_diff << " in texture coordinate";
+			}
+			else
+			{
+				std::cout << ", corners cannot be compared";
+			}
+			std::cout << (match ? ", match" : ", DIFFER") << std::endl;
+			all_match = all_match && match;
+		}
+		return all_match;
+#else
+		std::cout << "compare " << scene << " failed, built without DPML" << std::endl;
+		return false;
+#endif
+	}
+
+	/*!
+	 * @brief ___Scene::LoadTexture___
+	 * *******************************
+	 * Loads the texture of Textured mode from a 256 x 256 .tex file, builds
+	 * its mip chain and stores it in Morton order, which keeps the texels a
+	 * 2x2 quad reads close together at any orientation.
+	 * **************
+	 * @param path
+	 * : Path of the .tex file.
+	 * @return bool
+	 * : False if the .tex file could not be read.
+	*/
+	bool LoadTexture(const std::string& path)
+	{
+		if (!texture.load(path))
+		{
+			return false;
+		}
+		texture.build_mipmaps();
+		return texture.set_layout(GLPbo::Texture::Layout::Morton);
+	}
+
+	/*!
+	 * @brief ___Scene::NextModel___
+	 * *******************************
+	 * Displays the next model and resets relevant variables.
+	*/
+	void NextModel()
+	{
+		current_model = current_model + 1 >= models.size() ? 0 : current_model + 1;
+		current_draw_mode = DrawMode::Wireframe;
+		rotate = false;
+		orientation = 0.0;
+	}
+
+	/*!
+	 * @brief ___Scene::NextDrawMode___
+	 * **********************************
+	 * Changes the draw mode of the displayed model.
+	*/
+	void NextDrawMode()
+	{
+		if (current_draw_mode == DrawMode::Textured)
+		{
+			current_draw_mode = static_cast<DrawMode>(0);
+		}
+		else
+		{
+			current_draw_mode = static_cast<DrawMode>(static_cast<int>(current_draw_mode) + 1);
+		}
+	}
+
+	/*!
+	 * @brief ___Scene::NextTextureFilter___
+	 * ****************************************
+	 * Changes how the texture of Textured mode is filtered.
+	*/
+	void NextTextureFilter()
+	{
+		texture_filter = texture_filter == GLPbo::Texture::Filter::Trilinear ?
+			GLPbo::Texture::Filter::Nearest :
+			static_cast<GLPbo::Texture::Filter>(static_cast<int>(texture_filter) + 1);
+	}
+
+	/*!
+	 * @brief ___Scene::ToggleRotate___
+	 * ***********************************
+	 * Toggles if the current model should rotate or not.
+	*/
+	void ToggleRotate()
+	{
+		rotate = !rotate;
+	}
+
+	/*!
+	 * @brief ___Scene::Update___
+	 * *******************************
+	 * Advances the rotation of the current model, if toggled.
+	 * **************
+	 * @param delta_time
+	 * : Seconds since the previous frame.
+	*/
+	void Update(double delta_time)
+	{
+		if (rotate)
+		{
+			orientation += delta_time;
+		}
+	}
+
+	// per triangle colors handed to GLPbo::draw_elements(), kept from frame
+	// to frame
+	static std::vector<glm::vec3>	face_colors;
+
+	/*!
+	 * @brief ___Scene::DrawScene___
+	 * *******************************
+	 * Renders the current selected model with the draw mode selected.
+	*/
+	void DrawScene() 
+	{
+		GLPbo::Model& model = Scene::models[Scene::current_model];
+		size_t faces = model.triangle_cnt();
+
+		// random colors in range [-1,1] * 255, the same sequence every frame
+		// so triangles keep their colors
+		if (face_colors.size() < faces)
+		{
+			std::default_random_engine dre;
+			dre.seed(12);
+			std::uniform_real_distribution<float> urdf(-1.0, 1.0);
+			face_colors.resize(faces);
+			for (glm::vec3& clr : face_colors)
+			{
+				clr.x = urdf(dre) * 255.0f;
+				clr.y = urdf(dre) * 255.0f;
+				clr.z = urdf(dre) * 255.0f;
+			}
+		}
+
+		// update model transform, rotation about z applied first
+		glm::mat4 rotation{	 cos(orientation),  sin(orientation),	0,	0,
+							-sin(orientation),  cos(orientation),	0,	0,
+								0,		0,		1,	0,
+								0,		0,		0,	1 };
+
+		GLPbo::DrawState state;
+		state.mvp = view_projection * rotation;
+		state.line_clr = { 0,0,0,255 };
+		state.face_clr = face_colors.data();
+		state.texture = texture.levels > 0 ? &texture : nullptr;
+		state.filter = texture_filter;
+		GLPbo::draw_elements(model, current_draw_mode, state);
+	}
+}
@@ -0,0 +1,239 @@
+/* !
+@file    texture.cpp
+@author  z.tay@digipen.edu
+@date    18/10/2026
+
+This file contains the definition of GLPbo::Texture's functions, which
+read .tex images, build their mip chains and lay out their texels for the
+emulator's sampler in sampler.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "glpbo.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+/*!
+ * @brief ___PowerOfTwo___
+ * *******************************
+ * True if size is a positive power of two.
+*/
+static bool PowerOfTwo(GLsizei size)
+{
+	return size > 0 && (size & (size - 1)) == 0;
+}
+
+/*!
+ * @brief ___Spread___
+ * *******************************
+ * Moves bit i of a 16-bit value to bit 2i, the scalar counterpart of
+ * Sampler::Spread().
+*/
+static uint32_t Spread(uint32_t v)
+{
+	v = (v | (v << 8)) & 0x00FF00FF;
+	v = (v | (v << 4)) & 0x0F0F0F0F;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+/*!
+ * @brief ___Index___
+ * *******************************
+ * Index of texel (x, y) of a level of a texture in the given layout.
+*/
+static size_t Index(GLPbo::Texture const& t, GLPbo::Texture::Layout layout, GLint level, int32_t x, int32_t y)
+{
+	size_t offset = static_cast<size_t>(t.level_offset[level]);
+	if (layout == GLPbo::Texture::Layout::Morton)
+	{
+		return offset + (Spread(static_cast<uint32_t>(x)) | (Spread(static_cast<uint32_t>(y)) << 1));
+	}
+	return offset + static_cast<size_t>(y) * t.level_width[level] + x;
+}
+
+/*!
+ * @brief ___SetLevel___
+ * *******************************
+ * Fills the level tables of level l.
+*/
+static void SetLevel(GLPbo::Texture& t, GLint l, int32_t w, int32_t h, int32_t offset)
+{
+	t.level_width[l] = w;
+	t.level_height[l] = h;
+	t.level_offset[l] = offset;
+	t.level_xmask[l] = static_cast<int32_t>(Spread(static_cast<uint32_t>(w - 1)));
+	t.level_ymask[l] = static_cast<int32_t>(Spread(static_cast<uint32_t>(h - 1)) << 1);
+}
+
+/*!
+ * @brief ___Texture::load___
+ * ****************************************************************************************************
+ * Reads a w x h .tex file (raw RGBA bytes, like GLApp::setup_texobj()
+ * reads) into level 0. Any mip levels it had are dropped.
+ * ****************************************************************************************************
+ * @param path
+ * : Path of the .tex file.
+ * @param w, h
+ * : Size of the image, powers of two.
+ * @return bool
+ * : False, after printing why, if the file could not be read or a size is
+ * not a power of two.
+ * ****************************************************************************************************
+*/
+bool GLPbo::Texture::load(std::string const& path, GLsizei w, GLsizei h)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	std::vector<Color> image(static_cast<size_t>(std::max(w, 0)) * std::max(h, 0));
+	if (!file || !file.read(reinterpret_cast<char*>(image.data()), image.size() * sizeof(Color)))
+	{
+		std::cout << "read texture " << path << " failed" << std::endl;
+		return false;
+	}
+	return set_image(w, h, std::move(image));
+}
+
+/*!
+ * @brief ___Texture::set_image___
+ * ****************************************************************************************************
+ * Akin to glTexImage2D, makes w x h texels level 0 of a linear texture.
+ * Any mip levels it had are dropped.
+ * ****************************************************************************************************
+ * @param w, h
+ * : Size of the image, powers of two.
+ * @param image
+ * : w * h texels, row by row.
+ * @return bool
+ * : False, after printing why, if a size is not a power of two or the
+ * image is not w * h texels.
+ * ****************************************************************************************************
+*/
+bool GLPbo::Texture::set_image(GLsizei w, GLsizei h, std::vector<Color> image)
+{
+	if (!PowerOfTwo(w) || !PowerOfTwo(h) || image.size() != static_cast<size_t>(w) * h)
+	{
+		std::cout << "texture image is " << w << "x" << h << " with " << image.size() << " texels, sizes must be powers of two" << std::endl;
+		return false;
+	}
+
+	texels = std::move(image);
+	layout = Layout::Linear;
+	levels = 1;
+	SetLevel(*this, 0, w, h, 0);
+	return true;
+}
+
+/*!
+ * @brief ___Texture::build_mipmaps___
+ * ****************************************************************************************************
+ * Box filters level 0 down to 1 x 1 texel, akin to glGenerateMipmap. Each
+ * texel of a level is the rounded average of the 2x2 texels it covers in
+ * the level above, or of 2 texels once one side is down to 1. The levels
+ * are built in the texture's layout.
+ * ****************************************************************************************************
+*/
+void GLPbo::Texture::build_mipmaps()
+{
+	if (levels < 1)
+	{
+		return;
+	}
+
+	// sizes of the whole chain first, so texels is only allocated once
+	size_t count = static_cast<size_t>(level_width[0]) * level_height[0];
+	levels = 1;
+	while ((level_width[levels - 1] > 1 || level_height[levels - 1] > 1) && levels < max_levels)
+	{
+		int32_t w = std::max(level_width[levels - 1] / 2, 1), h = std::max(level_height[levels - 1] / 2, 1);
+		SetLevel(*this, levels, w, h, static_cast<int32_t>(count));
+		count += static_cast<size_t>(w) * h;
+		++levels;
+	}
+	texels.resize(count);
+
+	for (GLint l = 1; l < levels; ++l)
+	{
+		int32_t sw = level_width[l - 1], sh = level_height[l - 1];
+		for (int32_t y = 0; y < level_height[l]; ++y)
+		{
+			int32_t y0 = 2 * y, y1 = std::min(2 * y + 1, sh - 1);
+			for (int32_t x = 0; x < level_width[l]; ++x)
+			{
+				int32_t x0 = 2 * x, x1 = std::min(2 * x + 1, sw - 1);
+				Color const& c00 = texels[texel_index(l - 1, x0, y0)];
+				Color const& c10 = texels[texel_index(l - 1, x1, y0)];
+				Color const& c01 = texels[texel_index(l - 1, x0, y1)];
+				Color const& c11 = texels[texel_index(l - 1, x1, y1)];
+				Color& out = texels[texel_index(l, x, y)];
+				for (int c = 0; c < 4; ++c)
+				{
+					out.val[c] = static_cast<GLubyte>((c00.val[c] + c10.val[c] + c01.val[c] + c11.val[c] + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+/*!
+ * @brief ___Texture::set_layout___
+ * ****************************************************************************************************
+ * Reorders the texels of every level, once after loading, so the sampler
+ * never converts between layouts per texel.
+ * ****************************************************************************************************
+ * @param to
+ * : Layout to store the texels in.
+ * @return bool
+ * : False, after printing why, for Layout::Morton on a texture that is not
+ * square. The texture keeps its layout.
+ * ****************************************************************************************************
+*/
+bool GLPbo::Texture::set_layout(Layout to)
+{
+	if (to == layout || levels < 1)
+	{
+		layout = to;
+		return true;
+	}
+	// every level of a square texture is square, so Morton indices of a
+	// level are exactly [0, w * h)
+	if (to == Layout::Morton && level_width[0] != level_height[0])
+	{
+		std::cout << "texture is " << level_width[0] << "x" << level_height[0] << ", Morton layout needs a square" << std::endl;
+		return false;
+	}
+
+	std::vector<Color> reordered(texels.size());
+	for (GLint l = 0; l < levels; ++l)
+	{
+		for (int32_t y = 0; y < level_height[l]; ++y)
+		{
+			for (int32_t x = 0; x < level_width[l]; ++x)
+			{
+				reordered[Index(*this, to, l, x, y)] = texels[Index(*this, layout, l, x, y)];
+			}
+		}
+	}
+	texels = std::move(reordered);
+	layout = to;
+	return true;
+}
+
+/*!
+ * @brief ___Texture::texel_index___
+ * ****************************************************************************************************
+ * Index in texels of texel (x, y) of a level, in the texture's layout.
+ * ****************************************************************************************************
+ * @param level
+ * : Level in [0, levels).
+ * @param x, y
+ * : Texel coordinates, already wrapped to the level's size.
+ * ****************************************************************************************************
+*/
+size_t GLPbo::Texture::texel_index(GLint level, int32_t x, int32_t y) const
+{
+	return Index(*this, layout, level, x, y);
+}
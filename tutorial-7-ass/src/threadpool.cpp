@@ -0,0 +1,134 @@
+/* !
+@file    threadpool.cpp
+@author  z.tay@digipen.edu
+@date    17/10/2026
+
+This file contains the definition of member functions of class ThreadPool
+declared in threadpool.h.
+
+*//*__________________________________________________________________________*/
+
+/*                                                                   includes
+----------------------------------------------------------------------------- */
+#include "threadpool.h"
+
+/*!
+ * @brief ___ThreadPool::ThreadPool___
+ * ****************************************************************************************************
+ * Spawns the worker threads.
+ * ****************************************************************************************************
+*/
+ThreadPool::ThreadPool(unsigned thread_cnt)
+{
+	workers.reserve(thread_cnt);
+	for (unsigned i = 0; i < thread_cnt; ++i)
+	{
+		workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+/*!
+ * @brief ___ThreadPool::~ThreadPool___
+ * ****************************************************************************************************
+ * Wakes every worker with the quit flag set and joins them.
+ * ****************************************************************************************************
+*/
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		quit = true;
+	}
+	cv_start.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/*!
+ * @brief ___ThreadPool::ParallelFor___
+ * ****************************************************************************************************
+ * Posts a batch of tasks, works on it from the calling thread and waits
+ * for every worker to leave the batch.
+ * ****************************************************************************************************
+*/
+void ThreadPool::ParallelFor(unsigned count, std::function<void(unsigned)> const& fn)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	// not worth waking anyone for a single task
+	if (workers.empty() || count == 1)
+	{
+		for (unsigned i = 0; i < count; ++i)
+		{
+			fn(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		task = &fn;
+		task_cnt = count;
+		next_task.store(0, std::memory_order_relaxed);
+		busy = static_cast<unsigned>(workers.size());
+		++generation;
+	}
+	cv_start.notify_all();
+
+	RunTasks();
+
+	// workers still hold a pointer to fn, wait for all of them
+	std::unique_lock<std::mutex> lock(mtx);
+	cv_done.wait(lock, [this] { return busy == 0; });
+	task = nullptr;
+}
+
+/*!
+ * @brief ___ThreadPool::RunTasks___
+ * ****************************************************************************************************
+ * Pulls task indices of the current batch until none are left.
+ * ****************************************************************************************************
+*/
+void ThreadPool::RunTasks()
+{
+	for (unsigned i = next_task.fetch_add(1); i < task_cnt; i = next_task.fetch_add(1))
+	{
+		(*task)(i);
+	}
+}
+
+/*!
+ * @brief ___ThreadPool::WorkerLoop___
+ * ****************************************************************************************************
+ * Body of every worker thread. Sleeps until a new batch is posted, helps
+ * finish it, then reports back to ParallelFor().
+ * ****************************************************************************************************
+*/
+void ThreadPool::WorkerLoop()
+{
+	unsigned seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv_start.wait(lock, [this, seen] { return quit || generation != seen; });
+			if (quit)
+			{
+				return;
+			}
+			seen = generation;
+		}
+
+		RunTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			--busy;
+		}
+		cv_done.notify_one();
+	}
+}